@@ -355,7 +355,7 @@ cerr << "dimensions: " << (fullScreen() ? "(full)" : "") << endl
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FrameBufferGL::drawTIA(bool fullRedraw)
 {
-  const TIA& tia = myOSystem->console().tia();
+  const TIA& tia = displayedTIA();
 
   // Copy the mediasource framebuffer to the RGB texture
   uInt8* currentFrame  = tia.currentFrameBuffer();
@@ -372,6 +372,14 @@ void FrameBufferGL::drawTIA(bool fullRedraw)
     uInt32 screenofsY = 0;
     for(uInt32 y = 0; y < height; ++y )
     {
+      // Skip scanlines which haven't changed since the last frame
+      if(!fullRedraw && !tia.scanlineChanged(y))
+      {
+        bufofsY    += width;
+        screenofsY += pitch;
+        continue;
+      }
+
       uInt32 pos = screenofsY;
       for(uInt32 x = 0; x < width; ++x )
       {
@@ -155,7 +155,7 @@ bool FrameBufferSoft::setVidMode(VideoMode& mode)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FrameBufferSoft::drawTIA(bool fullRedraw)
 {
-  const TIA& tia = myOSystem->console().tia();
+  const TIA& tia = displayedTIA();
 
   uInt8* currentFrame   = tia.currentFrameBuffer();
   uInt8* previousFrame  = tia.previousFrameBuffer();
@@ -173,6 +173,14 @@ void FrameBufferSoft::drawTIA(bool fullRedraw)
             uInt32 screenofsY = 0;
             for(uInt32 y = 0; y < height; ++y)
             {
+                // Skip scanlines which haven't changed since the last frame
+                if(!fullRedraw && !tia.scanlineChanged(y))
+                {
+                    screenofsY += myPitch * myZoomLevel;
+                    bufofsY    += width;
+                    continue;
+                }
+
                 uInt32 ystride = myZoomLevel;
                 while(ystride--)
                 {
@@ -213,6 +221,14 @@ void FrameBufferSoft::drawTIA(bool fullRedraw)
       uInt32 screenofsY = 0;
       for(uInt32 y = 0; y < height; ++y)
       {
+        // Skip scanlines which haven't changed since the last frame
+        if(!fullRedraw && !tia.scanlineChanged(y))
+        {
+          screenofsY += myPitch * myZoomLevel;
+          bufofsY    += width;
+          continue;
+        }
+
         uInt32 ystride = myZoomLevel;
         while(ystride--)
         {
@@ -253,6 +269,14 @@ void FrameBufferSoft::drawTIA(bool fullRedraw)
       uInt32 screenofsY = 0;
       for(uInt32 y = 0; y < height; ++y)
       {
+        // Skip scanlines which haven't changed since the last frame
+        if(!fullRedraw && !tia.scanlineChanged(y))
+        {
+          screenofsY += myPitch * myZoomLevel;
+          bufofsY    += width;
+          continue;
+        }
+
         uInt32 ystride = myZoomLevel;
         while(ystride--)
         {
@@ -298,6 +322,14 @@ void FrameBufferSoft::drawTIA(bool fullRedraw)
       uInt32 screenofsY = 0;
       for(uInt32 y = 0; y < height; ++y)
       {
+        // Skip scanlines which haven't changed since the last frame
+        if(!fullRedraw && !tia.scanlineChanged(y))
+        {
+          screenofsY += myPitch * myZoomLevel;
+          bufofsY    += width;
+          continue;
+        }
+
         uInt32 ystride = myZoomLevel;
         while(ystride--)
         {
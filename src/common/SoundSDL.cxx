@@ -39,17 +39,32 @@
 
 #include "SoundSDL.hxx"
 
+// Keeps the memory accesses before it from being reordered with those
+// after it, by either the compiler or the processor
+#if defined(__GNUC__)
+  #define MEMORY_BARRIER() __sync_synchronize()
+#elif defined(_MSC_VER)
+  #include <windows.h>
+  #define MEMORY_BARRIER() MemoryBarrier()
+#else
+  #define MEMORY_BARRIER()
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 SoundSDL::SoundSDL(OSystem* osystem)
   : Sound(osystem),
     myIsEnabled(osystem->settings().getBool("sound")),
     myIsInitializedFlag(false),
     myLastRegisterSetCycle(0),
+    myDroppedRegisters(0),
+    myQueueDrained(false),
     myDisplayFrameRate(60.0),
     myNumChannels(1),
-    myFragmentSizeLogBase2(0),
+    myLatency(0.0),
+    myQueueAverage(0.0),
     myIsMuted(false),
-    myVolume(100)
+    myVolume(100),
+    myProcessingTime(0)
 {
 }
 
@@ -88,6 +103,7 @@ void SoundSDL::open()
     myIsInitializedFlag = false;
     myIsMuted = false;
     myLastRegisterSetCycle = 0;
+    myDroppedRegisters = 0;
 
     if(SDL_InitSubSystem(SDL_INIT_AUDIO) < 0)
     {
@@ -134,7 +150,8 @@ void SoundSDL::open()
 
       myIsInitializedFlag = true;
       myIsMuted = false;
-      myFragmentSizeLogBase2 = log((double)myHardwareSpec.samples) / log(2.0);
+      myLatency = myOSystem->settings().getInt("latency") / 1000.0;
+      myQueueAverage = 0.0;
 
 		/*
         cerr << "Freq: " << (int)myHardwareSpec.freq << endl;
@@ -162,6 +179,7 @@ void SoundSDL::open()
         cout << "Sound enabled:"  << endl
              << "  Volume     : " << myVolume << endl
              << "  Frag size  : " << fragsize << endl
+             << "  Latency    : " << (int)(myLatency * 1000) << " ms" << endl
              << "  Frequency  : " << myHardwareSpec.freq << endl
              << "  Format     : " << myHardwareSpec.format << endl
              << "  TIA Freq.  : " << tiafreq << endl
@@ -207,7 +225,9 @@ void SoundSDL::mute(bool state)
     myIsMuted = state;
 
     SDL_PauseAudio(myIsMuted ? 1 : 0);
+    SDL_LockAudio();
     myRegWriteQueue.clear();
+    SDL_UnlockAudio();
   }
 }
 
@@ -219,8 +239,12 @@ void SoundSDL::reset()
     SDL_PauseAudio(1);
     myIsMuted = false;
     myLastRegisterSetCycle = 0;
+    myDroppedRegisters = 0;
+    myQueueDrained = false;
+    SDL_LockAudio();
     myTIASound.reset();
     myRegWriteQueue.clear();
+    SDL_UnlockAudio();
     SDL_PauseAudio(0);
   }
 }
@@ -290,7 +314,13 @@ void SoundSDL::setFrameRate(float framerate)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL::set(uInt16 addr, uInt8 value, Int32 cycle)
 {
-  SDL_LockAudio();
+  // The audio callback filled a fragment without any writes left, so
+  // count this one from the start of the frame (see processFragment)
+  if(myQueueDrained)
+  {
+    myQueueDrained = false;
+    myLastRegisterSetCycle = 0;
+  }
 
   // First, calulate how many seconds would have past since the last
   // register write on a real 2600
@@ -303,16 +333,45 @@ void SoundSDL::set(uInt16 addr, uInt8 value, Int32 cycle)
   // values to "scale" the time before the register change occurs.
 // FIXME - this always results in 1.0, so we don't really need it
 //  delta = delta * (myDisplayFrameRate / myOSystem->frameRate());
+  // The queue only fills up if the callback hasn't run for a long time
+  // (it trims the queue otherwise), in which case the write is held back
+  // rather than waiting for room.  Only the latest value of each register
+  // matters, so those are replayed (at the time of this write) as soon
+  // as there's room again, ahead of this one.
+  bool queued = false;
+  for(uInt16 reg = 0; reg < 6 && myDroppedRegisters != 0; ++reg)
+  {
+    if(myDroppedRegisters & (1 << reg))
+    {
+      RegWrite dropped;
+      dropped.addr = 0x15 + reg;
+      dropped.value = myDroppedValues[reg];
+      dropped.delta = queued ? 0.0 : delta;
+      if(!myRegWriteQueue.enqueue(dropped))
+        break;
+
+      myDroppedRegisters &= ~(1 << reg);
+      queued = true;
+    }
+  }
+
   RegWrite info;
   info.addr = addr;
   info.value = value;
-  info.delta = delta;
-  myRegWriteQueue.enqueue(info);
+  info.delta = queued ? 0.0 : delta;
 
-  // Update last cycle counter to the current cycle
-  myLastRegisterSetCycle = cycle;
+  if(myDroppedRegisters == 0 && myRegWriteQueue.enqueue(info))
+    queued = true;
+  else if(addr >= 0x15 && addr <= 0x1a)
+  {
+    myDroppedValues[addr - 0x15] = value;
+    myDroppedRegisters |= 1 << (addr - 0x15);
+  }
 
-  SDL_UnlockAudio();
+  // Update last cycle counter to the current cycle, unless nothing was
+  // queued, so the next write carries the time since the last one that was
+  if(queued)
+    myLastRegisterSetCycle = cycle;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -324,21 +383,42 @@ void SoundSDL::processFragment(uInt8* stream, Int32 length)
   uInt32 channels = myHardwareSpec.channels;
   length = length / channels;
 
-  // If there are excessive items on the queue then we'll remove some
-  if(myRegWriteQueue.duration() > 
-      (myFragmentSizeLogBase2 / myDisplayFrameRate))
+  // The amount of sound to keep queued; there must always be enough to
+  // get through this fragment and until the next frame is emulated
+  double fragment = (double)length / myHardwareSpec.freq;
+  double frame = 1.0 / myDisplayFrameRate;
+  double target = myLatency > 0.0 ? myLatency : fragment + 2.0 * frame;
+  if(target < fragment + frame)
+    target = fragment + frame;
+
+  double queued = myRegWriteQueue.duration();
+
+  // If there are excessive items on the queue (the emulation may have
+  // got well ahead) then we'll remove some straight away
+  if(queued > 2.0 * target)
   {
-    double removed = 0.0;
-    while(removed < ((myFragmentSizeLogBase2 - 1) / myDisplayFrameRate))
+    while(queued > target && myRegWriteQueue.size() > 0)
     {
       RegWrite& info = myRegWriteQueue.front();
-      removed += info.delta;
+      queued -= info.delta;
       myTIASound.set(info.addr, info.value);
       myRegWriteQueue.dequeue();
     }
-//    cout << "Removed Items from RegWriteQueue!" << endl;
+    myQueueAverage = queued;
   }
 
+  // Otherwise the emulation and the sound device drift apart slowly, so
+  // the sound is played up to half a percent faster when more than the
+  // target is queued, and slower when less is, which can't be heard.
+  // The queue grows by a frame whenever one is emulated, so it's
+  // averaged over about a second.
+  myQueueAverage += (queued - myQueueAverage) * BSPF_min(fragment, 1.0);
+  double adjust = (myQueueAverage - target) / target * 0.02;
+  adjust = BSPF_max(-0.005, BSPF_min(adjust, 0.005));
+
+  // The number of samples played per second of emulated sound
+  double rate = myHardwareSpec.freq / (1.0 + adjust);
+
   double position = 0.0;
   double remaining = length;
 
@@ -355,8 +435,9 @@ void SoundSDL::processFragment(uInt8* stream, Int32 length)
       // Since we had to fill the fragment we'll reset the cycle counter
       // to zero.  NOTE: This isn't 100% correct, however, it'll do for
       // now.  We should really remember the overrun and remove it from
-      // the delta of the next write.
-      myLastRegisterSetCycle = 0;
+      // the delta of the next write.  The counter belongs to the
+      // emulation thread, so it's asked to do the reset itself.
+      myQueueDrained = true;
       break;
     }
     else
@@ -366,7 +447,7 @@ void SoundSDL::processFragment(uInt8* stream, Int32 length)
       RegWrite& info = myRegWriteQueue.front();
 
       // How long will the remaining samples in the fragment take to play
-      double duration = remaining / (double)myHardwareSpec.freq;
+      double duration = remaining / rate;
 
       // Does the register update occur before the end of the fragment?
       if(info.delta <= duration)
@@ -377,7 +458,7 @@ void SoundSDL::processFragment(uInt8* stream, Int32 length)
         {
           // Process the fragment upto the next TIA register write.  We
           // round the count passed to process up if needed.
-          double samples = (myHardwareSpec.freq * info.delta);
+          double samples = (rate * info.delta);
 //        myTIASound.process(stream + (uInt32)position, (uInt32)samples +
 //            (uInt32)(position + samples) - 
 //            ((uInt32)position + (uInt32)samples));
@@ -410,8 +491,13 @@ void SoundSDL::processFragment(uInt8* stream, Int32 length)
 void SoundSDL::callback(void* udata, uInt8* stream, int len)
 {
   SoundSDL* sound = (SoundSDL*)udata;
+  uInt32 start = PerfCounters::ticks();
   sound->processFragment(stream, (Int32)len);
 
+  // The main thread only ever reads this, so the callback needn't lock
+  sound->myProcessingTime = sound->myProcessingTime +
+                            (PerfCounters::ticks() - start);
+
 #ifdef SPEAKJET_EMULATION
 //  cerr << "SoundSDL::callback(): len==" << len << endl;
 
@@ -453,12 +539,15 @@ bool SoundSDL::load(Deserializer& in)
     reg6 = (uInt8) in.getByte();
 
     myLastRegisterSetCycle = (Int32) in.getInt();
+    myDroppedRegisters = 0;
+    myQueueDrained = false;
 
     // Only update the TIA sound registers if sound is enabled
     // Make sure to empty the queue of previous sound fragments
     if(myIsInitializedFlag)
     {
       SDL_PauseAudio(1);
+      SDL_LockAudio();
       myRegWriteQueue.clear();
       myTIASound.set(0x15, reg1);
       myTIASound.set(0x16, reg2);
@@ -466,6 +555,7 @@ bool SoundSDL::load(Deserializer& in)
       myTIASound.set(0x18, reg4);
       myTIASound.set(0x19, reg5);
       myTIASound.set(0x1a, reg6);
+      SDL_UnlockAudio();
       SDL_PauseAudio(0);
     }
   }
@@ -530,13 +620,13 @@ bool SoundSDL::save(Serializer& out)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 SoundSDL::RegWriteQueue::RegWriteQueue(uInt32 capacity)
-  : myCapacity(capacity),
-    myBuffer(0),
-    mySize(0),
+  : myBuffer(0),
+    myMask(capacity - 1),
     myHead(0),
     myTail(0)
 {
-  myBuffer = new RegWrite[myCapacity];
+  assert(capacity > 1 && (capacity & (capacity - 1)) == 0);
+  myBuffer = new RegWrite[capacity];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -548,71 +638,63 @@ SoundSDL::RegWriteQueue::~RegWriteQueue()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL::RegWriteQueue::clear()
 {
-  myHead = myTail = mySize = 0;
+  myHead = myTail = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL::RegWriteQueue::dequeue()
 {
-  if(mySize > 0)
+  uInt32 head = myHead;
+  if(head != myTail)
   {
-    myHead = (myHead + 1) % myCapacity;
-    --mySize;
+    // Finish with the item before handing its slot back
+    MEMORY_BARRIER();
+    myHead = (head + 1) & myMask;
   }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 double SoundSDL::RegWriteQueue::duration()
 {
+  uInt32 head = myHead, tail = myTail;
+  MEMORY_BARRIER();
+
   double duration = 0.0;
-  for(uInt32 i = 0; i < mySize; ++i)
+  for(uInt32 i = head; i != tail; i = (i + 1) & myMask)
   {
-    duration += myBuffer[(myHead + i) % myCapacity].delta;
+    duration += myBuffer[i].delta;
   }
   return duration;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL::RegWriteQueue::enqueue(const RegWrite& info)
+bool SoundSDL::RegWriteQueue::enqueue(const RegWrite& info)
 {
-  // If an attempt is made to enqueue more than the queue can hold then
-  // we'll enlarge the queue's capacity.
-  if(mySize == myCapacity)
-  {
-    grow();
-  }
+  uInt32 tail = myTail;
+  uInt32 next = (tail + 1) & myMask;
+  if(next == myHead)
+    return false;
+
+  // The item must be complete before the callback can see it
+  myBuffer[tail] = info;
+  MEMORY_BARRIER();
+  myTail = next;
 
-  myBuffer[myTail] = info;
-  myTail = (myTail + 1) % myCapacity;
-  ++mySize;
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 SoundSDL::RegWrite& SoundSDL::RegWriteQueue::front()
 {
-  assert(mySize != 0);
+  assert(size() != 0);
+  MEMORY_BARRIER();
   return myBuffer[myHead];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 SoundSDL::RegWriteQueue::size() const
 {
-  return mySize;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL::RegWriteQueue::grow()
-{
-  RegWrite* buffer = new RegWrite[myCapacity * 2];
-  for(uInt32 i = 0; i < mySize; ++i)
-  {
-    buffer[i] = myBuffer[(myHead + i) % myCapacity];
-  }
-  myHead = 0;
-  myTail = mySize;
-  myCapacity = myCapacity * 2;
-  delete[] myBuffer;
-  myBuffer = buffer;
+  return (myTail - myHead) & myMask;
 }
 
 #endif  // SOUND_SUPPORT
@@ -137,6 +137,14 @@ class SoundSDL : public Sound
     */
     void adjustVolume(Int8 direction);
 
+    /**
+      Answers the total host time spent generating samples, in
+      microseconds.  This is a copy of a running total which only the
+      audio callback writes (and never resets), so it may be read from
+      the main thread without locking.
+    */
+    uInt32 processingTime() const { return myProcessingTime; }
+
   public:
     /**
       Loads the current state of this device from the given Deserializer.
@@ -175,16 +183,23 @@ class SoundSDL : public Sound
     /**
       A queue class used to hold TIA sound register writes before being
       processed while creating a sound fragment.
+
+      The emulation thread is the only one to enqueue writes, and the
+      audio callback is the only one to look at and dequeue them, so
+      the queue needs no locking.  Each side owns one index (kept on
+      its own cache line) and only reads the other's; an item is fully
+      written before the index covering it is moved.  The capacity is
+      fixed, so nothing is ever allocated while the queue is in use.
     */
     class RegWriteQueue
     {
       public:
         /**
-          Create a new queue instance with the specified initial
-          capacity.  If the queue ever reaches its capacity then it will
-          automatically increase its size.
+          Create a new queue instance with the specified capacity,
+          which must be a power of two.  One item less than the
+          capacity can be held at once.
         */
-        RegWriteQueue(uInt32 capacity = 512);
+        RegWriteQueue(uInt32 capacity = 8192);
 
         /**
           Destroy this queue instance.
@@ -193,27 +208,32 @@ class SoundSDL : public Sound
 
       public:
         /**
-          Clear any items stored in the queue.
+          Clear any items stored in the queue.  This may only be called
+          while the audio callback isn't running.
         */
         void clear();
 
         /**
-          Dequeue the first object in the queue.
+          Dequeue the first object in the queue (audio callback only).
         */
         void dequeue();
 
         /**
-          Return the duration of all the items in the queue.
+          Return the duration of all the items in the queue (audio
+          callback only).
         */
         double duration();
 
         /**
-          Enqueue the specified object.
+          Enqueue the specified object (emulation thread only).
+
+          @return False if the queue was full and the object was dropped
         */
-        void enqueue(const RegWrite& info);
+        bool enqueue(const RegWrite& info);
 
         /**
-          Return the item at the front on the queue.
+          Return the item at the front on the queue (audio callback
+          only).  The queue must not be empty.
 
           @return The item at the front of the queue.
         */
@@ -227,15 +247,25 @@ class SoundSDL : public Sound
         uInt32 size() const;
 
       private:
-        // Increase the size of the queue
-        void grow();
+        // Copy constructor and assignment operator not supported
+        RegWriteQueue(const RegWriteQueue&);
+        RegWriteQueue& operator = (const RegWriteQueue&);
 
       private:
-        uInt32 myCapacity;
+        enum { CacheLineSize = 64 };
+
+        // The items, and the capacity minus one for wrapping an index
         RegWrite* myBuffer;
-        uInt32 mySize;
-        uInt32 myHead;
-        uInt32 myTail;
+        uInt32 myMask;
+
+        // Index of the front item; only moved by the audio callback
+        char myPad1[CacheLineSize];
+        volatile uInt32 myHead;
+
+        // Index after the last item; only moved by the emulation thread
+        char myPad2[CacheLineSize - sizeof(uInt32)];
+        volatile uInt32 myTail;
+        char myPad3[CacheLineSize - sizeof(uInt32)];
     };
 
   private:
@@ -251,14 +281,25 @@ class SoundSDL : public Sound
     // Indicates the cycle when a sound register was last set
     Int32 myLastRegisterSetCycle;
 
+    // The latest values written to AUDC0 - AUDV1 which didn't fit in the
+    // queue, and a bit (from AUDC0 up) for each one waiting to be replayed
+    uInt8 myDroppedValues[6];
+    uInt8 myDroppedRegisters;
+
+    // Set by the audio callback when it runs out of register writes,
+    // so the emulation thread restarts its cycle count
+    volatile bool myQueueDrained;
+
     // Indicates the base framerate depending on if the ROM is NTSC or PAL
     float myDisplayFrameRate;
 
     // Indicates the number of channels (mono or stereo)
     uInt32 myNumChannels;
 
-    // Log base 2 of the selected fragment size
-    double myFragmentSizeLogBase2;
+    // The sound to keep queued, in seconds (0 for a fragment plus two
+    // frames), and the amount queued averaged over the last second or so
+    double myLatency;
+    double myQueueAverage;
 
     // Indicates if the sound is currently muted
     bool myIsMuted;
@@ -266,6 +307,10 @@ class SoundSDL : public Sound
     // Current volume as a percentage (0 - 100)
     uInt32 myVolume;
 
+    // Total host time spent generating samples, in microseconds; only
+    // written by the audio callback
+    volatile uInt32 myProcessingTime;
+
     // Audio specification structure
     SDL_AudioSpec myHardwareSpec;
 
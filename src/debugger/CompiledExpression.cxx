@@ -0,0 +1,355 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include "Debugger.hxx"
+#include "Expression.hxx"
+#include "CompiledExpression.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CompiledExpression::CompiledExpression()
+  : myDebugger(0),
+    myDependencies(DepAlways),
+    myFoldBarrier(0),
+    myDepth(0),
+    myMaxDepth(0),
+    myFunctionDepth(0),
+    myResult(0)
+{
+  myRAMMask[0] = myRAMMask[1] = myRAMMask[2] = myRAMMask[3] = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CompiledExpression::~CompiledExpression()
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::compile(Expression* exp, Debugger& debugger)
+{
+  myCode.clear();
+  myDebugger = &debugger;
+  myDependencies = 0;
+  myRAMMask[0] = myRAMMask[1] = myRAMMask[2] = myRAMMask[3] = 0;
+  myFoldBarrier = 0;
+  myDepth = myMaxDepth = 0;
+  myFunctionDepth = 0;
+
+  exp->compile(*this);
+
+  // Expressions too deep for the stack are walked as a tree instead
+  if(myMaxDepth > kStackSize)
+  {
+    myCode.clear();
+    myDependencies = 0;
+    myDepth = myMaxDepth = 0;
+    emitEvaluate(exp);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt16 CompiledExpression::evaluate()
+{
+  uInt16 stack[kStackSize];
+  int sp = -1;
+
+  const Instruction* code = myCode.begin();
+  int size = myCode.size();
+  for(int pc = 0; pc < size; ++pc)
+  {
+    const Instruction& ins = code[pc];
+    switch(ins.op)
+    {
+      case kConst:
+        stack[++sp] = ins.value;
+        break;
+
+      case kCpuMethod:
+        stack[++sp] = (myDebugger->cpuDebug().*ins.cpuMethod)();
+        break;
+
+      case kTiaMethod:
+        stack[++sp] = (myDebugger->tiaDebug().*ins.tiaMethod)();
+        break;
+
+      case kEvaluate:
+        stack[++sp] = ins.exp->evaluate();
+        break;
+
+      case kByteDeref:
+        stack[sp] = myDebugger->peek(stack[sp]);
+        break;
+
+      case kWordDeref:
+        stack[sp] = myDebugger->dpeek(stack[sp]);
+        break;
+
+      case kAndJump:
+        // Leave the (false) left operand as the result, or drop it
+        // and continue with the right operand
+        if(stack[sp] == 0)
+          pc = ins.value - 1;
+        else
+          --sp;
+        break;
+
+      case kOrJump:
+        if(stack[sp] != 0)
+        {
+          stack[sp] = 1;
+          pc = ins.value - 1;
+        }
+        else
+          --sp;
+        break;
+
+      case kUnaryMinus:
+      case kBinNot:
+      case kLogNot:
+      case kLoByte:
+      case kHiByte:
+      case kBool:
+        stack[sp] = apply(ins.op, stack[sp], 0);
+        break;
+
+      default:
+        --sp;
+        stack[sp] = apply(ins.op, stack[sp], stack[sp+1]);
+        break;
+    }
+  }
+
+  myResult = sp >= 0 ? stack[sp] : 0;
+  return myResult;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt16 CompiledExpression::apply(Opcode op, uInt16 lhs, uInt16 rhs)
+{
+  switch(op)
+  {
+    case kUnaryMinus:    return -lhs;
+    case kBinNot:        return ~lhs;
+    case kLogNot:        return !lhs;
+    case kLoByte:        return 0xff & lhs;
+    case kHiByte:        return 0xff & (lhs >> 8);
+    case kBool:          return lhs != 0;
+    case kPlus:          return lhs + rhs;
+    case kMinus:         return lhs - rhs;
+    case kMult:          return lhs * rhs;
+    case kDiv:           return rhs == 0 ? 0 : lhs / rhs;
+    case kMod:           return rhs == 0 ? 0 : lhs % rhs;
+    case kBinAnd:        return lhs & rhs;
+    case kBinOr:         return lhs | rhs;
+    case kBinXor:        return lhs ^ rhs;
+    case kShiftLeft:     return lhs << rhs;
+    case kShiftRight:    return lhs >> rhs;
+    case kLess:          return lhs < rhs;
+    case kGreater:       return lhs > rhs;
+    case kLessEquals:    return lhs <= rhs;
+    case kGreaterEquals: return lhs >= rhs;
+    case kEquals:        return lhs == rhs;
+    case kNotEquals:     return lhs != rhs;
+    default:             return 0;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emit(Opcode op)
+{
+  switch(op)
+  {
+    case kByteDeref:
+    case kWordDeref:
+      // Reads from a known address only depend on that location
+      if(foldable(1))
+      {
+        int address = myCode[myCode.size() - 1].value;
+        dependOnAddress(address);
+        if(op == kWordDeref)
+          dependOnAddress(address + 1);
+      }
+      else
+        myDependencies |= DepAlways;
+      push(op);
+      break;
+
+    case kUnaryMinus:
+    case kBinNot:
+    case kLogNot:
+    case kLoByte:
+    case kHiByte:
+    case kBool:
+      if(foldable(1))
+      {
+        Instruction& ins = myCode[myCode.size() - 1];
+        ins.value = apply(op, ins.value, 0);
+      }
+      else
+        push(op);
+      break;
+
+    case kConst:
+    case kCpuMethod:
+    case kTiaMethod:
+    case kEvaluate:
+    case kAndJump:
+    case kOrJump:
+      // These need an operand, and are emitted by the other methods
+      assert(false);
+      break;
+
+    default:
+      if(foldable(2))
+      {
+        uInt16 rhs = myCode.remove_at(myCode.size() - 1).value;
+        Instruction& ins = myCode[myCode.size() - 1];
+        ins.value = apply(op, ins.value, rhs);
+        myDepth--;
+      }
+      else
+      {
+        push(op);
+        myDepth--;
+      }
+      break;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emitConst(int value)
+{
+  push(kConst, (uInt16)value);
+  myDepth++;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emitCpuMethod(CPUDEBUG_INT_METHOD method)
+{
+  if(method == &CpuDebug::a)       myDependencies |= DepA;
+  else if(method == &CpuDebug::x)  myDependencies |= DepX;
+  else if(method == &CpuDebug::y)  myDependencies |= DepY;
+  else if(method == &CpuDebug::sp) myDependencies |= DepSP;
+  else if(method == &CpuDebug::pc) myDependencies |= DepPC;
+  else if(method == &CpuDebug::n || method == &CpuDebug::v ||
+          method == &CpuDebug::b || method == &CpuDebug::d ||
+          method == &CpuDebug::i || method == &CpuDebug::z ||
+          method == &CpuDebug::c)  myDependencies |= DepPS;
+  else                             myDependencies |= DepAlways;
+
+  push(kCpuMethod);
+  myCode[myCode.size() - 1].cpuMethod = method;
+  myDepth++;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emitTiaMethod(TIADEBUG_INT_METHOD method)
+{
+  // TIA state changes with every clock
+  myDependencies |= DepAlways;
+
+  push(kTiaMethod);
+  myCode[myCode.size() - 1].tiaMethod = method;
+  myDepth++;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emitEvaluate(Expression* exp)
+{
+  // Nothing is known about what the tree reads
+  myDependencies |= DepAlways;
+
+  push(kEvaluate);
+  myCode[myCode.size() - 1].exp = exp;
+  myDepth++;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emitFunction(Expression* exp)
+{
+  if(exp == 0)
+    emitConst(0);
+  else if(myFunctionDepth >= kMaxFunctionDepth)
+    emitEvaluate(exp);
+  else
+  {
+    myFunctionDepth++;
+    exp->compile(*this);
+    myFunctionDepth--;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emitLogical(Opcode op, Expression* lhs, Expression* rhs)
+{
+  lhs->compile(*this);
+
+  uInt32 jump = myCode.size();
+  push(op);
+  myDepth--;
+
+  rhs->compile(*this);
+  emit(kBool);
+
+  // The end of the right operand is the target of the jump
+  myCode[jump].value = myCode.size();
+  myFoldBarrier = myCode.size();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::dependOnAddress(int address)
+{
+  // Only the RIOT RAM (and its mirrors) is known to change just when
+  // it's written; everything else is re-read after every instruction
+  address &= 0x1fff;
+  if((address & 0x1280) == 0x0080)
+  {
+    myRAMMask[(address >> 5) & 0x03] |= 1 << (address & 0x1f);
+    myDependencies |= DepRAM;
+  }
+  else
+    myDependencies |= DepAlways;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CompiledExpression::foldable(uInt32 count) const
+{
+  uInt32 size = myCode.size();
+  if(size < count || size - count < myFoldBarrier)
+    return false;
+
+  for(uInt32 i = size - count; i < size; ++i)
+    if(myCode[i].op != kConst)
+      return false;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::push(Opcode op, int value)
+{
+  Instruction ins;
+  ins.op = op;
+  ins.value = value;
+  ins.cpuMethod = 0;
+  ins.tiaMethod = 0;
+  ins.exp = 0;
+  myCode.push_back(ins);
+
+  if(myDepth + 1 > myMaxDepth)
+    myMaxDepth = myDepth + 1;
+}
@@ -0,0 +1,177 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef COMPILED_EXPRESSION_HXX
+#define COMPILED_EXPRESSION_HXX
+
+class Debugger;
+class Expression;
+
+#include "bspf.hxx"
+#include "Array.hxx"
+#include "CpuDebug.hxx"
+#include "TIADebug.hxx"
+
+/**
+  This class holds an expression tree compiled into a flat postfix
+  program, which is evaluated on a small value stack instead of
+  walking the tree through virtual calls.  It is used for conditional
+  breakpoints, which are checked after every instruction.
+
+  While compiling, constant subexpressions are folded, and the values
+  the expression reads are recorded (CPU registers and RIOT RAM
+  locations).  The processor uses this to re-evaluate a condition
+  only when something it depends on has actually changed.
+
+  Equates and functions are resolved when the expression is compiled,
+  so it should be recompiled whenever execution resumes.
+
+  @author  Stella team
+  @version $Id$
+*/
+class CompiledExpression
+{
+  public:
+    /**
+      The values an expression can depend on
+    */
+    enum Dependency
+    {
+      DepA      = 1 << 0,
+      DepX      = 1 << 1,
+      DepY      = 1 << 2,
+      DepSP     = 1 << 3,
+      DepPC     = 1 << 4,
+      DepPS     = 1 << 5,
+      DepRAM    = 1 << 6,  // One of the locations in ramMask()
+      DepAlways = 1 << 7   // Anything else (TIA state, I/O, ROM, ...)
+    };
+
+    /**
+      Instructions of the compiled program.  Operators take their
+      operands from the stack and push their result, in the same order
+      as the corresponding Expression.
+    */
+    enum Opcode
+    {
+      kConst, kCpuMethod, kTiaMethod, kEvaluate,
+      kByteDeref, kWordDeref,
+      kUnaryMinus, kBinNot, kLogNot, kLoByte, kHiByte, kBool,
+      kPlus, kMinus, kMult, kDiv, kMod,
+      kBinAnd, kBinOr, kBinXor, kShiftLeft, kShiftRight,
+      kLess, kGreater, kLessEquals, kGreaterEquals, kEquals, kNotEquals,
+      kAndJump, kOrJump
+    };
+
+  public:
+    CompiledExpression();
+    virtual ~CompiledExpression();
+
+  public:
+    /**
+      Compile the given expression tree, replacing any previous program.
+
+      @param exp       The expression to compile
+      @param debugger  The debugger used to access the emulation
+    */
+    void compile(Expression* exp, Debugger& debugger);
+
+    /**
+      Run the program, and remember the result.
+
+      @return The value of the expression
+    */
+    uInt16 evaluate();
+
+    /**
+      Get the value computed by the last call to evaluate().
+    */
+    uInt16 result() const { return myResult; }
+
+    /**
+      Get the values this expression depends on, as Dependency bits.
+    */
+    uInt32 dependencies() const { return myDependencies; }
+
+    /**
+      Get the RIOT RAM locations read by the expression, as a 128-bit
+      mask (bit n of word n/32 for location $80 + n).
+    */
+    const uInt32* ramMask() const { return myRAMMask; }
+
+  public:
+    /**
+      The following methods are used by Expression::compile() to
+      emit the program for each node of the tree.
+    */
+    void emit(Opcode op);
+    void emitConst(int value);
+    void emitCpuMethod(CPUDEBUG_INT_METHOD method);
+    void emitTiaMethod(TIADEBUG_INT_METHOD method);
+    void emitEvaluate(Expression* exp);
+    void emitFunction(Expression* exp);
+    void emitLogical(Opcode op, Expression* lhs, Expression* rhs);
+
+    Debugger& debugger() const { return *myDebugger; }
+
+  private:
+    // Record a dependency on the memory location read at address
+    void dependOnAddress(int address);
+
+    // Apply a unary or binary operator, with the same semantics as
+    // the corresponding Expression::evaluate()
+    static uInt16 apply(Opcode op, uInt16 lhs, uInt16 rhs);
+
+    // Can the last count instructions be folded into a constant?
+    bool foldable(uInt32 count) const;
+
+    void push(Opcode op, int value = 0);
+
+  private:
+    struct Instruction
+    {
+      Opcode op;
+      int value;  // Constant or jump target
+      CPUDEBUG_INT_METHOD cpuMethod;
+      TIADEBUG_INT_METHOD tiaMethod;
+      Expression* exp;
+    };
+
+    enum {
+      kStackSize = 64,      // Maximum depth of the value stack
+      kMaxFunctionDepth = 8 // Maximum nesting of inlined functions
+    };
+
+    Common::Array<Instruction> myCode;
+    Debugger* myDebugger;
+
+    uInt32 myDependencies;
+    uInt32 myRAMMask[4];
+
+    // Instructions before this index are the target of a jump,
+    // so they can't be folded with the following ones
+    uInt32 myFoldBarrier;
+
+    // Current and maximum depth of the stack while compiling
+    int myDepth, myMaxDepth;
+    int myFunctionDepth;
+
+    uInt16 myResult;
+};
+
+#endif
@@ -229,7 +229,7 @@ int CpuDebug::disassemble(int address, string& result, EquateList& list)
 // makes like much easier for the expression parser.
 int CpuDebug::getBank()
 {
-  return Debugger::debugger().getBank();
+  return myDebugger.getBank();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -28,8 +28,8 @@ class EquateList;
 // pointer types for CpuDebug instance methods
 typedef int (CpuDebug::*CPUDEBUG_INT_METHOD)();
 
-// call the pointed-to method on the (global) CPU debugger object.
-#define CALL_CPUDEBUG_METHOD(method) ( ( Debugger::debugger().cpuDebug().*method)() )
+// call the pointed-to method on the CPU debugger object of the given debugger.
+#define CALL_CPUDEBUG_METHOD(debugger, method) ( ( (debugger).cpuDebug().*method)() )
 
 class CpuState : public DebuggerState
 {
@@ -53,8 +53,6 @@
 
 #include "Debugger.hxx"
 
-Debugger* Debugger::myStaticDebugger;
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 static const string builtin_functions[][3] = {
   // { "name", "definition", "help text" }
@@ -123,12 +121,6 @@ Debugger::Debugger(OSystem* osystem)
   myBreakPoints = new PackedBitArray(0x10000);
   myReadTraps = new PackedBitArray(0x10000);
   myWriteTraps = new PackedBitArray(0x10000);
-
-  // Allow access to this object from any class
-  // Technically this violates pure OO programming, but since I know
-  // there will only be ever one instance of debugger in Stella,
-  // I don't care :)
-  myStaticDebugger = this;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -348,7 +340,7 @@ void Debugger::autoExec()
   for(int i = 0; builtin_functions[i][0] != ""; i++)
   {
     // TODO - check this for memory leaks
-    int res = YaccParser::parse(builtin_functions[i][1].c_str());
+    int res = YaccParser::parse(builtin_functions[i][1].c_str(), *this);
     if(res != 0) cerr << "ERROR in builtin function!" << endl;
     Expression* exp = YaccParser::getResult();
     addFunction(builtin_functions[i][0], builtin_functions[i][1], exp, true);
@@ -505,20 +497,20 @@ int Debugger::trace()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Debugger::toggleBreakPoint(int bp)
 {
-  mySystem->m6502().setBreakPoints(myBreakPoints);
   if(bp < 0) bp = myCpuDebug->pc();
   myBreakPoints->toggle(bp);
+  mySystem->m6502().setBreakPoints(myBreakPoints);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Debugger::setBreakPoint(int bp, bool set)
 {
-  mySystem->m6502().setBreakPoints(myBreakPoints);
   if(bp < 0) bp = myCpuDebug->pc();
   if(set)
     myBreakPoints->set(bp);
   else
     myBreakPoints->clear(bp);
+  mySystem->m6502().setBreakPoints(myBreakPoints);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -531,15 +523,15 @@ bool Debugger::breakPoint(int bp)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Debugger::toggleReadTrap(int t)
 {
-  mySystem->m6502().setTraps(myReadTraps, myWriteTraps);
   myReadTraps->toggle(t);
+  mySystem->m6502().setTraps(myReadTraps, myWriteTraps);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Debugger::toggleWriteTrap(int t)
 {
-  mySystem->m6502().setTraps(myReadTraps, myWriteTraps);
   myWriteTraps->toggle(t);
+  mySystem->m6502().setTraps(myReadTraps, myWriteTraps);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -60,8 +60,8 @@ enum {
 typedef uInt8 (Debugger::*DEBUGGER_BYTE_METHOD)();
 typedef uInt16 (Debugger::*DEBUGGER_WORD_METHOD)();
 
-// call the pointed-to method on the (static) debugger object.
-#define CALL_DEBUGGER_METHOD(method) ( ( Debugger::debugger().*method)() )
+// call the pointed-to method on the given debugger object.
+#define CALL_DEBUGGER_METHOD(debugger, method) ( ( (debugger).*method)() )
 */
 
 
@@ -275,16 +275,6 @@ class Debugger : public DialogContainer
     /* Invert given input if it differs from its previous value */
     const string invIfChanged(int reg, int oldReg);
 
-    /**
-      This is used when we want the debugger from a class that can't
-      receive the debugger object in any other way.
-
-      It's basically a hack to prevent the need to pass debugger objects
-      everywhere, but I feel it's better to place it here then in
-      YaccParser (which technically isn't related to it at all).
-    */
-    static Debugger& debugger() { return *myStaticDebugger; }
-
     /**
       Get the dimensions of the various debugger dialog areas
       (takes mediasource into account)
@@ -389,8 +379,6 @@ class Debugger : public DialogContainer
 
     ListFile sourceLines;
 
-    static Debugger* myStaticDebugger;
-
     FunctionMap functions;
     FunctionDefMap functionDefs;
 
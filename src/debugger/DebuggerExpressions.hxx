@@ -24,6 +24,7 @@
 #include "Debugger.hxx"
 #include "TIADebug.hxx"
 #include "Expression.hxx"
+#include "CompiledExpression.hxx"
 
 /**
   All expressions currently supported by the debugger.
@@ -36,6 +37,8 @@ class BinAndExpression : public Expression
   public:
     BinAndExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() & myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kBinAnd); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -44,6 +47,7 @@ class BinNotExpression : public Expression
   public:
     BinNotExpression(Expression* left) : Expression(left, 0) {}
     uInt16 evaluate() { return ~(myLHS->evaluate()); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); code.emit(CompiledExpression::kBinNot); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -52,6 +56,8 @@ class BinOrExpression : public Expression
   public:
     BinOrExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() | myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kBinOr); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -60,22 +66,37 @@ class BinXorExpression : public Expression
   public:
     BinXorExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() ^ myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kBinXor); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class ByteDerefExpression : public Expression
 {
   public:
-    ByteDerefExpression(Expression* left): Expression(left, 0) {}
-    uInt16 evaluate() { return Debugger::debugger().peek(myLHS->evaluate()); }
+    ByteDerefExpression(Debugger& debugger, Expression* left)
+      : Expression(left, 0), myDebugger(debugger) {}
+    uInt16 evaluate() { return myDebugger.peek(myLHS->evaluate()); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); code.emit(CompiledExpression::kByteDeref); }
+
+  private:
+    Debugger& myDebugger;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class ByteDerefOffsetExpression : public Expression
 {
   public:
-    ByteDerefOffsetExpression(Expression* left, Expression* right) : Expression(left, right) {}
-    uInt16 evaluate() { return Debugger::debugger().peek(myLHS->evaluate() + myRHS->evaluate()); }
+    ByteDerefOffsetExpression(Debugger& debugger, Expression* left, Expression* right)
+      : Expression(left, right), myDebugger(debugger) {}
+    uInt16 evaluate() { return myDebugger.peek(myLHS->evaluate() + myRHS->evaluate()); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kPlus);
+                                             code.emit(CompiledExpression::kByteDeref);
+                                           }
+
+  private:
+    Debugger& myDebugger;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -84,6 +105,7 @@ class ConstExpression : public Expression
   public:
     ConstExpression(const int value) : Expression(0, 0), myValue(value) {}
     uInt16 evaluate() { return myValue; }
+    void compile(CompiledExpression& code) { code.emitConst(myValue); }
 
   private:
     int myValue;
@@ -93,10 +115,13 @@ class ConstExpression : public Expression
 class CpuMethodExpression : public Expression
 {
   public:
-    CpuMethodExpression(CPUDEBUG_INT_METHOD method) : Expression(0, 0), myMethod(method) {}
-    uInt16 evaluate() { return CALL_CPUDEBUG_METHOD(myMethod); }
+    CpuMethodExpression(Debugger& debugger, CPUDEBUG_INT_METHOD method)
+      : Expression(0, 0), myDebugger(debugger), myMethod(method) {}
+    uInt16 evaluate() { return CALL_CPUDEBUG_METHOD(myDebugger, myMethod); }
+    void compile(CompiledExpression& code) { code.emitCpuMethod(myMethod); }
 
   private:
+    Debugger& myDebugger;
     CPUDEBUG_INT_METHOD myMethod;
 };
 
@@ -108,6 +133,8 @@ class DivExpression : public Expression
     uInt16 evaluate() { int denom = myRHS->evaluate();
                         return denom == 0 ? 0 : myLHS->evaluate() / denom;
                       }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kDiv); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -116,16 +143,21 @@ class EqualsExpression : public Expression
   public:
     EqualsExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() == myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kEquals); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class EquateExpression : public Expression
 {
   public:
-    EquateExpression(const string& label) : Expression(0, 0), myLabel(label) {}
-    uInt16 evaluate() { return Debugger::debugger().equates().getAddress(myLabel); }
+    EquateExpression(Debugger& debugger, const string& label)
+      : Expression(0, 0), myDebugger(debugger), myLabel(label) {}
+    uInt16 evaluate() { return myDebugger.equates().getAddress(myLabel); }
+    void compile(CompiledExpression& code) { code.emitConst(myDebugger.equates().getAddress(myLabel)); }
 
   private:
+    Debugger& myDebugger;
     string myLabel;
 };
 
@@ -133,14 +165,17 @@ class EquateExpression : public Expression
 class FunctionExpression : public Expression
 {
   public:
-    FunctionExpression(const string& label) : Expression(0, 0), myLabel(label) {}
+    FunctionExpression(Debugger& debugger, const string& label)
+      : Expression(0, 0), myDebugger(debugger), myLabel(label) {}
     uInt16 evaluate() {
-        Expression* exp = Debugger::debugger().getFunction(myLabel);
+        Expression* exp = myDebugger.getFunction(myLabel);
         if(exp) return exp->evaluate();
         else return 0;
     }
+    void compile(CompiledExpression& code) { code.emitFunction(myDebugger.getFunction(myLabel)); }
 
   private:
+    Debugger& myDebugger;
     string myLabel;
 };
 
@@ -150,6 +185,8 @@ class GreaterEqualsExpression : public Expression
   public:
     GreaterEqualsExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() >= myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kGreaterEquals); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -158,6 +195,8 @@ class GreaterExpression : public Expression
   public:
     GreaterExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() > myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kGreater); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -166,6 +205,7 @@ class HiByteExpression : public Expression
   public:
     HiByteExpression(Expression* left) : Expression(left, 0) {}
     uInt16 evaluate() { return 0xff & (myLHS->evaluate() >> 8); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); code.emit(CompiledExpression::kHiByte); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -174,6 +214,8 @@ class LessEqualsExpression : public Expression
   public:
     LessEqualsExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() <= myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kLessEquals); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -182,6 +224,8 @@ class LessExpression : public Expression
   public:
     LessExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() < myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kLess); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -190,6 +234,7 @@ class LoByteExpression : public Expression
   public:
     LoByteExpression(Expression* left) : Expression(left, 0) {}
     uInt16 evaluate() { return 0xff & myLHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); code.emit(CompiledExpression::kLoByte); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -198,6 +243,7 @@ class LogAndExpression : public Expression
   public:
     LogAndExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() && myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { code.emitLogical(CompiledExpression::kAndJump, myLHS, myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -206,6 +252,7 @@ class LogNotExpression : public Expression
   public:
     LogNotExpression(Expression* left) : Expression(left, 0) {}
     uInt16 evaluate() { return !(myLHS->evaluate()); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); code.emit(CompiledExpression::kLogNot); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -214,6 +261,7 @@ class LogOrExpression : public Expression
   public:
     LogOrExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() || myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { code.emitLogical(CompiledExpression::kOrJump, myLHS, myRHS); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -222,6 +270,8 @@ class MinusExpression : public Expression
   public:
     MinusExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() - myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kMinus); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -232,6 +282,8 @@ class ModExpression : public Expression
     uInt16 evaluate() { int rhs = myRHS->evaluate();
                         return rhs == 0 ? 0 : myLHS->evaluate() % rhs;
                       }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kMod); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -240,6 +292,8 @@ class MultExpression : public Expression
   public:
     MultExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() * myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kMult); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -248,6 +302,8 @@ class NotEqualsExpression : public Expression
   public:
     NotEqualsExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() != myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kNotEquals); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -256,6 +312,8 @@ class PlusExpression : public Expression
   public:
     PlusExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() + myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kPlus); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -264,6 +322,8 @@ class ShiftLeftExpression : public Expression
   public:
     ShiftLeftExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() << myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kShiftLeft); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -272,16 +332,21 @@ class ShiftRightExpression : public Expression
   public:
     ShiftRightExpression(Expression* left, Expression* right) : Expression(left, right) {}
     uInt16 evaluate() { return myLHS->evaluate() >> myRHS->evaluate(); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); myRHS->compile(code);
+                                             code.emit(CompiledExpression::kShiftRight); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class TiaMethodExpression : public Expression
 {
   public:
-    TiaMethodExpression(TIADEBUG_INT_METHOD method) : Expression(0, 0), myMethod(method) {}
-    uInt16 evaluate() { return CALL_TIADEBUG_METHOD(myMethod); }
+    TiaMethodExpression(Debugger& debugger, TIADEBUG_INT_METHOD method)
+      : Expression(0, 0), myDebugger(debugger), myMethod(method) {}
+    uInt16 evaluate() { return CALL_TIADEBUG_METHOD(myDebugger, myMethod); }
+    void compile(CompiledExpression& code) { code.emitTiaMethod(myMethod); }
 
   private:
+    Debugger& myDebugger;
     TIADEBUG_INT_METHOD myMethod;
 };
 
@@ -291,14 +356,20 @@ class UnaryMinusExpression : public Expression
   public:
     UnaryMinusExpression(Expression* left) : Expression(left, 0) {}
     uInt16 evaluate() { return -(myLHS->evaluate()); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); code.emit(CompiledExpression::kUnaryMinus); }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class WordDerefExpression : public Expression
 {
   public:
-    WordDerefExpression(Expression* left) : Expression(left, 0) {}
-    uInt16 evaluate() { return Debugger::debugger().dpeek(myLHS->evaluate()); }
+    WordDerefExpression(Debugger& debugger, Expression* left)
+      : Expression(left, 0), myDebugger(debugger) {}
+    uInt16 evaluate() { return myDebugger.dpeek(myLHS->evaluate()); }
+    void compile(CompiledExpression& code) { myLHS->compile(code); code.emit(CompiledExpression::kWordDeref); }
+
+  private:
+    Debugger& myDebugger;
 };
 
 #endif
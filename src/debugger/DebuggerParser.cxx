@@ -69,7 +69,7 @@ string DebuggerParser::run(const string& command)
   if(strncmp(command.c_str(), "expr ", 5) == 0) {
     delete lastExpression;
     commandResult = "parser test: status==";
-    int status = YaccParser::parse(command.c_str() + 5);
+    int status = YaccParser::parse(command.c_str() + 5, *debugger);
     commandResult += debugger->valueToString(status);
     commandResult += ", result==";
     if(status == 0) {
@@ -432,7 +432,7 @@ bool DebuggerParser::getArgs(const string& command, string& verb)
   */
 
   for(int i = 0; i < argCount; i++) {
-    int err = YaccParser::parse(argStrings[i].c_str());
+    int err = YaccParser::parse(argStrings[i].c_str(), *debugger);
     if(err) {
       args.push_back(-1);
     } else {
@@ -749,7 +749,7 @@ void DebuggerParser::executeBreak()
 // "breakif"
 void DebuggerParser::executeBreakif()
 {
-  int res = YaccParser::parse(argStrings[0].c_str());
+  int res = YaccParser::parse(argStrings[0].c_str(), *debugger);
   if(res == 0) {
     // I hate this().method().chaining().crap()
     unsigned int ret = debugger->cpuDebug().m6502().addCondBreak(
@@ -962,7 +962,7 @@ void DebuggerParser::executeFunction()
     return;
   }
 
-  int res = YaccParser::parse(argStrings[1].c_str());
+  int res = YaccParser::parse(argStrings[1].c_str(), *debugger);
   if(res == 0) {
     debugger->addFunction(argStrings[0], argStrings[1], YaccParser::getResult());
     commandResult = "Added function " + argStrings[0];
@@ -17,6 +17,7 @@
 //============================================================================
 
 #include "Expression.hxx"
+#include "CompiledExpression.hxx"
 
 #ifdef EXPR_REF_COUNT
 #include "bspf.hxx"
@@ -44,3 +45,9 @@ Expression::~Expression()
   delete myLHS;
   delete myRHS;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Expression::compile(CompiledExpression& code)
+{
+  code.emitEvaluate(this);
+}
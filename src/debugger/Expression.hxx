@@ -19,6 +19,8 @@
 #ifndef EXPRESSION_HXX
 #define EXPRESSION_HXX
 
+class CompiledExpression;
+
 #include "bspf.hxx"
 
 // define this to count Expression instances. Only useful for debugging
@@ -42,6 +44,15 @@ class Expression
 
     virtual uInt16 evaluate() = 0;
 
+    /**
+      Emit the postfix program for this node (and its children) into
+      the given compiled expression.  Nodes which don't know how to
+      compile themselves are evaluated as a tree.
+
+      @param code  The compiled expression being built
+    */
+    virtual void compile(CompiledExpression& code);
+
   protected:
     Expression* myLHS;
     Expression* myRHS;
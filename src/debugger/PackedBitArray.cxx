@@ -21,6 +21,7 @@
 
 PackedBitArray::PackedBitArray(int length) {
 	size = length;
+	setBits = 0;
 	words = length / wordSize + 1;
 	bits = new unsigned int[ words ];
 
@@ -51,12 +52,15 @@ void PackedBitArray::toggle(unsigned int bit) {
 	bit %= wordSize;
 
 	bits[word] ^= (1 << bit);
+	setBits += (bits[word] & (1 << bit)) ? 1 : -1;
 }
 
 void PackedBitArray::set(unsigned int bit) {
 	unsigned int word = bit / wordSize;
 	bit %= wordSize;
 
+	if(!(bits[word] & (1 << bit)))
+		setBits++;
 	bits[word] |= (1 << bit);
 }
 
@@ -64,5 +68,7 @@ void PackedBitArray::clear(unsigned int bit) {
 	unsigned int word = bit / wordSize;
 	bit %= wordSize;
 
+	if(bits[word] & (1 << bit))
+		setBits--;
 	bits[word] &= (~(1 << bit));
 }
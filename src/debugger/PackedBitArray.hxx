@@ -35,6 +35,9 @@ class PackedBitArray {
 		void clear(unsigned int bit);
 		void toggle(unsigned int bit);
 
+		// true if no bits are set
+		bool isEmpty() const { return setBits == 0; }
+
 	private:
 		// number of bits in the array:
 		int size;
@@ -44,6 +47,9 @@ class PackedBitArray {
 
 		// the array itself:
 		unsigned int *bits;
+
+		// number of bits currently set:
+		int setBits;
 };
 
 #endif
@@ -325,6 +325,7 @@ bool TIADebug::collision(int collID, int newVal)
 {
   unsigned int mask = 1 << collID;
 
+  myTIA.resolveCollisions();
   if(newVal > -1)
   {
     if(newVal)
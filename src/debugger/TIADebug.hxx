@@ -30,8 +30,8 @@ class TiaDebug;
 // (used by TiaMethodExpression)
 typedef int (TIADebug::*TIADEBUG_INT_METHOD)();
 
-// call the pointed-to method on the (global) debugger object.
-#define CALL_TIADEBUG_METHOD(method) ( ( Debugger::debugger().tiaDebug().*method)() )
+// call the pointed-to method on the TIA debugger object of the given debugger.
+#define CALL_TIADEBUG_METHOD(debugger, method) ( ( (debugger).tiaDebug().*method)() )
 
 enum TIALabel {
 	VSYNC = 0,
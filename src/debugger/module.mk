@@ -1,6 +1,7 @@
 MODULE := src/debugger
 
 MODULE_OBJS := \
+	src/debugger/CompiledExpression.o \
 	src/debugger/Debugger.o \
 	src/debugger/DebuggerParser.o \
 	src/debugger/EquateList.o \
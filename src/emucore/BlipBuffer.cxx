@@ -0,0 +1,121 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <cmath>
+#include <cstring>
+
+#include "BlipBuffer.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BlipBuffer::BlipBuffer()
+  : myBuffer(0),
+    myCapacity(0),
+    myLevel(0)
+{
+  memset(myKernel, 0, sizeof(myKernel));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BlipBuffer::~BlipBuffer()
+{
+  delete[] myBuffer;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BlipBuffer::setRates(Int32 outputFrequency, Int32 inputFrequency)
+{
+  const double pi = 3.14159265358979323846;
+
+  // Nothing above half the lower of the two rates can be reproduced, so
+  // that's where the steps are cut off (in cycles per output sample),
+  // leaving a little room for the filter to roll off
+  double cutoff = 0.45;
+  if(inputFrequency < outputFrequency)
+    cutoff = cutoff * inputFrequency / outputFrequency;
+
+  for(uInt32 phase = 0; phase < Phases; ++phase)
+  {
+    // The change happens this far past the sample before the first tap,
+    // and the middle of the step is Width / 2 samples later still
+    double offset = 1.0 - (phase + 0.5) / Phases - Width / 2;
+
+    // A Blackman windowed sinc
+    double taps[Width], sum = 0.0;
+    for(uInt32 i = 0; i < Width; ++i)
+    {
+      double x = i + offset;
+      double y = 2.0 * pi * cutoff * x;
+      double sinc = x == 0.0 ? 1.0 : sin(y) / y;
+      double window = 0.42 + 0.5 * cos(2.0 * pi * x / Width) +
+                      0.08 * cos(4.0 * pi * x / Width);
+      taps[i] = sinc * window;
+      sum += taps[i];
+    }
+
+    // Each step must add up to exactly one, or the level would drift
+    Int32 total = 0;
+    uInt32 largest = 0;
+    for(uInt32 i = 0; i < Width; ++i)
+    {
+      myKernel[phase][i] = (Int32) floor(taps[i] / sum * (1 << FracBits) + 0.5);
+      total += myKernel[phase][i];
+      if(myKernel[phase][i] > myKernel[phase][largest])
+        largest = i;
+    }
+    myKernel[phase][largest] += (1 << FracBits) - total;
+  }
+
+  // Room for a chunk, the steps running past its end, and the samples
+  // a single clock of the waveform can pass
+  delete[] myBuffer;
+  myCapacity = ChunkSize + Width + 2;
+  if(inputFrequency > 0)
+    myCapacity += outputFrequency / inputFrequency;
+  myBuffer = new Int32[myCapacity];
+
+  clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BlipBuffer::clear()
+{
+  if(myBuffer)
+    memset(myBuffer, 0, myCapacity * sizeof(Int32));
+  myLevel = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BlipBuffer::readSamples(uInt8* buffer, uInt32 count, uInt32 stride,
+                             Int32 bias)
+{
+  Int32 level = myLevel;
+  for(uInt32 i = 0; i < count; ++i)
+  {
+    level += myBuffer[i];
+
+    // The steps overshoot a little, which mustn't wrap around
+    Int32 sample = (level >> FracBits) + bias;
+    *buffer = sample < 0 ? 0 : (sample > 255 ? 255 : sample);
+    buffer += stride;
+  }
+  myLevel = level;
+
+  // Move the steps still to be read to the start
+  memmove(myBuffer, myBuffer + count, (myCapacity - count) * sizeof(Int32));
+  memset(myBuffer + myCapacity - count, 0, count * sizeof(Int32));
+}
@@ -0,0 +1,122 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef BLIP_BUFFER_HXX
+#define BLIP_BUFFER_HXX
+
+#include "bspf.hxx"
+
+/**
+  This class implements band-limited synthesis of a waveform made of
+  steps, such as the square waves of the TIA.  Rather than being given
+  samples, it's told when and by how much the level changes, and adds a
+  band-limited step (an integrated windowed sinc) to its buffer for each
+  change.  Reading samples back integrates those steps.
+
+  So the cost depends on the number of level changes rather than on the
+  number of samples, and a waveform at one rate can be turned into
+  samples at another without aliasing.  The output is delayed by half
+  the width of a step.
+
+  @author  Stella team
+  @version $Id$
+*/
+class BlipBuffer
+{
+  public:
+    enum {
+      Width     = 16,              // samples each step is spread over
+      PhaseBits = 5,
+      Phases    = 1 << PhaseBits,  // sub-sample positions of a step
+      FracBits  = 15,              // fixed point bits of a step's taps
+      ChunkSize = 512              // most samples which are read at once
+    };
+
+    /**
+      Create a new buffer; setRates() must be called before it's used.
+    */
+    BlipBuffer();
+
+    /**
+      Destructor
+    */
+    virtual ~BlipBuffer();
+
+  public:
+    /**
+      Set the rate samples are read at, and the rate of the waveform.
+      This builds the steps, and clears the buffer.
+
+      @param outputFrequency  The rate of the samples read
+      @param inputFrequency   The rate the waveform is clocked at
+    */
+    void setRates(Int32 outputFrequency, Int32 inputFrequency);
+
+    /**
+      Throw away all the steps added, and the current level.
+    */
+    void clear();
+
+    /**
+      Add a change of level to the buffer.  Changes must be added in
+      order, and not before the samples already read.
+
+      @param offset    The sample (counted from the next one to be read)
+                       which the change comes just before
+      @param fraction  How far past the sample before that one the
+                       change happens, in 1/65536ths of a sample
+      @param delta     The amount the level changes by
+    */
+    void addDelta(uInt32 offset, uInt32 fraction, Int32 delta)
+    {
+      // A fixed length loop over plain arrays, which the compiler is
+      // able to turn into vector instructions
+      const Int32* step = myKernel[fraction >> (16 - PhaseBits)];
+      Int32* out = myBuffer + offset;
+      for(uInt32 i = 0; i < Width; ++i)
+        out[i] += step[i] * delta;
+    }
+
+    /**
+      Read samples from the buffer, clamped to 8 bits.
+
+      @param buffer  The location to store the samples
+      @param count   The number of samples to read (at most ChunkSize)
+      @param stride  The distance between samples in the buffer
+      @param bias    The value added to each sample
+    */
+    void readSamples(uInt8* buffer, uInt32 count, uInt32 stride, Int32 bias);
+
+  private:
+    // Copy constructor and assignment operator not supported
+    BlipBuffer(const BlipBuffer&);
+    BlipBuffer& operator = (const BlipBuffer&);
+
+  private:
+    // The differences of a step, for each phase
+    Int32 myKernel[Phases][Width];
+
+    // The differences of the steps added, starting at the next sample
+    Int32* myBuffer;
+    uInt32 myCapacity;
+
+    // The sum of the differences read so far, which is the current level
+    Int32 myLevel;
+};
+
+#endif
@@ -48,13 +48,15 @@
 #include "CartUA.hxx"
 #include "CartSB.hxx"
 #include "CartX07.hxx"
+#include "DetectionCache.hxx"
 #include "MD5.hxx"
 #include "Props.hxx"
 #include "Settings.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Cartridge* Cartridge::create(const uInt8* image, uInt32 size,
-    const Properties& properties, const Settings& settings)
+    const Properties& properties, const Settings& settings,
+    DetectionCache* cache)
 {
   Cartridge* cartridge = 0;
 
@@ -81,7 +83,14 @@ Cartridge* Cartridge::create(const uInt8* image, uInt32 size,
   string autodetect = "";
   if(type == "AUTO-DETECT" || settings.getBool("rominfo"))
   {
-    string detected = autodetectType(image, size);
+    // Scanning the image is only needed the first time a ROM is seen
+    string detected;
+    if(!(cache && md5 != "" && cache->getCartType(md5, detected)))
+    {
+      detected = autodetectType(image, size);
+      if(cache && md5 != "")
+        cache->setCartType(md5, detected);
+    }
     autodetect = "*";
     if(type != "AUTO-DETECT" && type != detected)
       cerr << "Auto-detection not consistent: " << type << ", " << detected << endl;
@@ -89,7 +98,6 @@ Cartridge* Cartridge::create(const uInt8* image, uInt32 size,
     type = detected;
   }
   buf << type << autodetect << " (" << (size/1024) << "K) ";
-  myAboutString = buf.str();
 
   // We should know the cart's type by now so let's create it
   if(type == "2K")
@@ -149,6 +157,9 @@ Cartridge* Cartridge::create(const uInt8* image, uInt32 size,
   else
     cerr << "ERROR: Invalid cartridge type " << type << " ..." << endl;
 
+  if(cartridge != 0)
+    cartridge->myAboutString = buf.str();
+
   return cartridge;
 }
 
@@ -549,6 +560,3 @@ Cartridge& Cartridge::operator = (const Cartridge&)
   assert(false);
   return *this;
 }
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-string Cartridge::myAboutString= "";
@@ -25,6 +25,7 @@ class Cartridge;
 class System;
 class Properties;
 class Settings;
+class DetectionCache;
 
 #include "bspf.hxx"
 #include "Device.hxx"
@@ -47,10 +48,12 @@ class Cartridge : public Device
       @param size     The size of the ROM image 
       @param props    The properties associated with the game
       @param settings The settings associated with the system
+      @param cache    Optional cache of previously autodetected types
       @return   Pointer to the new cartridge object allocated on the heap
     */
     static Cartridge* create(const uInt8* image, uInt32 size, 
-        const Properties& props, const Settings& settings);
+        const Properties& props, const Settings& settings,
+        DetectionCache* cache = 0);
 
     /**
       Create a new cartridge
@@ -65,7 +68,16 @@ class Cartridge : public Device
     /**
       Query some information about this cartridge.
     */
-    static const string& about() { return myAboutString; }
+    const string& about() const { return myAboutString; }
+
+    /**
+      Try to auto-detect the bankswitching type of the cartridge
+
+      @param image  A pointer to the ROM image
+      @param size   The size of the ROM image 
+      @return The "best guess" for the cartridge type
+    */
+    static string autodetectType(const uInt8* image, uInt32 size);
 
     /**
       Save the internal (patched) ROM image.
@@ -148,15 +160,6 @@ class Cartridge : public Device
     bool myBankLocked;
 
   private:
-    /**
-      Try to auto-detect the bankswitching type of the cartridge
-
-      @param image  A pointer to the ROM image
-      @param size   The size of the ROM image 
-      @return The "best guess" for the cartridge type
-    */
-    static string autodetectType(const uInt8* image, uInt32 size);
-
     /**
       Search the image for the specified byte signature
 
@@ -234,7 +237,7 @@ class Cartridge : public Device
 
   private:
     // Contains info about this cartridge in string format
-    static string myAboutString;
+    string myAboutString;
 
     // Copy constructor isn't supported by cartridges so make it private
     Cartridge(const Cartridge&);
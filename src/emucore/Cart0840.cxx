@@ -146,6 +146,7 @@ void Cartridge0840::poke(uInt16 address, uInt8 value)
 void Cartridge0840::bank(uInt16 bank)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentBank = bank;
@@ -19,7 +19,6 @@
 #include <cassert>
 #include <cstring>
 
-#include "Random.hxx"
 #include "System.hxx"
 #include "TIA.hxx"
 #include "Cart3E.hxx"
@@ -45,7 +44,7 @@ Cartridge3E::~Cartridge3E()
 void Cartridge3E::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 32768; ++i)
     myRam[i] = random.next();
 
@@ -133,6 +132,7 @@ void Cartridge3E::poke(uInt16 address, uInt8 value)
 void Cartridge3E::bank(uInt16 bank)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   if(bank < 256)
   {
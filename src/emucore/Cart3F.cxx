@@ -118,6 +118,7 @@ void Cartridge3F::poke(uInt16 address, uInt8 value)
 void Cartridge3F::bank(uInt16 bank)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Make sure the bank they're asking for is reasonable
   if((uInt32)bank * 2048 < mySize)
@@ -19,7 +19,6 @@
 #include <cassert>
 #include <cstring>
 
-#include "Random.hxx"
 #include "System.hxx"
 #include "M6532.hxx"
 #include "TIA.hxx"
@@ -46,7 +45,7 @@ Cartridge4A50::~Cartridge4A50()
 void Cartridge4A50::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 32768; ++i)
     myRAM[i] = random.next();
 
@@ -181,6 +180,13 @@ void Cartridge4A50::checkBankSwitch(uInt16 address, uInt8 value)
 {
   if(myBankLocked) return;
 
+  // Remember the mapping, so that only a real change is counted as a
+  // bankswitch
+  uInt16 sliceLow = mySliceLow, sliceMiddle = mySliceMiddle,
+         sliceHigh = mySliceHigh;
+  bool isRomLow = myIsRomLow, isRomMiddle = myIsRomMiddle,
+       isRomHigh = myIsRomHigh;
+
   // This scheme contains so many hotspots that it's easier to just check
   // all of them
   if(((myLastData & 0xe0) == 0x60) &&      // Switch lower/middle/upper bank
@@ -277,6 +283,11 @@ void Cartridge4A50::checkBankSwitch(uInt16 address, uInt8 value)
       mySliceMiddle = (value & 0xf) << 11;
     }
   }
+
+  if(mySliceLow != sliceLow || mySliceMiddle != sliceMiddle ||
+     mySliceHigh != sliceHigh || myIsRomLow != isRomLow ||
+     myIsRomMiddle != isRomMiddle || myIsRomHigh != isRomHigh)
+    mySystem->counters().count(PerfCounters::BankSwitches);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
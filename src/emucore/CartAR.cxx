@@ -20,7 +20,6 @@
 #include <cstring>
 
 #include "M6502Hi.hxx"
-#include "Random.hxx"
 #include "System.hxx"
 #include "CartAR.hxx"
 
@@ -47,7 +46,7 @@ CartridgeAR::~CartridgeAR()
 void CartridgeAR::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 6 * 1024; ++i)
     myImage[i] = random.next();
 
@@ -421,6 +420,7 @@ void CartridgeAR::loadIntoRAM(uInt8 load)
 void CartridgeAR::bank(uInt16 bank)
 {
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   bankConfiguration(bank);
 }
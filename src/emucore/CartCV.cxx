@@ -19,7 +19,6 @@
 #include <cassert>
 #include <cstring>
 
-#include "Random.hxx"
 #include "System.hxx"
 #include "CartCV.hxx"
 
@@ -49,7 +48,7 @@ void CartridgeCV::reset()
     memcpy(myImage, myROM, 2048);
 
     // Initialize RAM with random values
-    class Random random;
+    Random& random = mySystem->randGenerator();
     for(uInt32 i = 0; i < 1024; ++i)
       myRAM[i] = random.next();
   }
@@ -424,6 +424,7 @@ void CartridgeDPC::poke(uInt16 address, uInt8 value)
 void CartridgeDPC::bank(uInt16 bank)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentBank = bank;
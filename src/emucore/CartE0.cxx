@@ -128,6 +128,7 @@ void CartridgeE0::poke(uInt16 address, uInt8)
 void CartridgeE0::segmentZero(uInt16 slice)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember the new slice
   myCurrentSlice[0] = slice;
@@ -150,6 +151,7 @@ void CartridgeE0::segmentZero(uInt16 slice)
 void CartridgeE0::segmentOne(uInt16 slice)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember the new slice
   myCurrentSlice[1] = slice;
@@ -172,6 +174,7 @@ void CartridgeE0::segmentOne(uInt16 slice)
 void CartridgeE0::segmentTwo(uInt16 slice)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember the new slice
   myCurrentSlice[2] = slice;
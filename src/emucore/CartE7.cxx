@@ -19,7 +19,6 @@
 #include <cassert>
 #include <cstring>
 
-#include "Random.hxx"
 #include "System.hxx"
 #include "CartE7.hxx"
 
@@ -39,7 +38,7 @@ CartridgeE7::~CartridgeE7()
 void CartridgeE7::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 2048; ++i)
     myRAM[i] = random.next();
 
@@ -160,6 +159,7 @@ void CartridgeE7::bankRAM(uInt16 bank)
 void CartridgeE7::bank(uInt16 slice)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentSlice[0] = slice;
@@ -91,6 +91,7 @@ void CartridgeEF::poke(uInt16 address, uInt8)
 void CartridgeEF::bank(uInt16 bank)
 {
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentBank = bank;
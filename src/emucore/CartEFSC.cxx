@@ -19,7 +19,6 @@
 #include <cassert>
 #include <cstring>
 
-#include "Random.hxx"
 #include "System.hxx"
 #include "CartEFSC.hxx"
 
@@ -39,7 +38,7 @@ CartridgeEFSC::~CartridgeEFSC()
 void CartridgeEFSC::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 128; ++i)
     myRAM[i] = random.next();
 
@@ -122,6 +121,7 @@ void CartridgeEFSC::poke(uInt16 address, uInt8)
 void CartridgeEFSC::bank(uInt16 bank)
 {
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentBank = bank;
@@ -18,7 +18,6 @@
 
 #include <cassert>
 
-#include "Random.hxx"
 #include "System.hxx"
 #include "CartF4.hxx"
 
@@ -98,6 +97,7 @@ void CartridgeF4::poke(uInt16 address, uInt8)
 void CartridgeF4::bank(uInt16 bank)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentBank = bank;
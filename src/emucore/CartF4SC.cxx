@@ -19,7 +19,6 @@
 #include <cassert>
 #include <cstring>
 
-#include "Random.hxx"
 #include "System.hxx"
 #include "CartF4SC.hxx"
 
@@ -39,7 +38,7 @@ CartridgeF4SC::~CartridgeF4SC()
 void CartridgeF4SC::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 128; ++i)
     myRAM[i] = random.next();
 
@@ -124,6 +123,7 @@ void CartridgeF4SC::poke(uInt16 address, uInt8)
 void CartridgeF4SC::bank(uInt16 bank)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentBank = bank;
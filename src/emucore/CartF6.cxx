@@ -141,6 +141,7 @@ void CartridgeF6::poke(uInt16 address, uInt8)
 void CartridgeF6::bank(uInt16 bank)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentBank = bank;
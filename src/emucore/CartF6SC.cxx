@@ -19,7 +19,6 @@
 #include <cassert>
 #include <cstring>
 
-#include "Random.hxx"
 #include "System.hxx"
 #include "CartF6SC.hxx"
 
@@ -39,7 +38,7 @@ CartridgeF6SC::~CartridgeF6SC()
 void CartridgeF6SC::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 128; ++i)
     myRAM[i] = random.next();
 
@@ -168,6 +167,7 @@ void CartridgeF6SC::poke(uInt16 address, uInt8)
 void CartridgeF6SC::bank(uInt16 bank)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentBank = bank;
@@ -121,6 +121,7 @@ void CartridgeF8::poke(uInt16 address, uInt8)
 void CartridgeF8::bank(uInt16 bank)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentBank = bank;
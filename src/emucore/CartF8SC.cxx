@@ -19,7 +19,6 @@
 #include <cassert>
 #include <cstring>
 
-#include "Random.hxx"
 #include "System.hxx"
 #include "CartF8SC.hxx"
 
@@ -39,7 +38,7 @@ CartridgeF8SC::~CartridgeF8SC()
 void CartridgeF8SC::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 128; ++i)
     myRAM[i] = random.next();
 
@@ -148,6 +147,7 @@ void CartridgeF8SC::poke(uInt16 address, uInt8)
 void CartridgeF8SC::bank(uInt16 bank)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentBank = bank;
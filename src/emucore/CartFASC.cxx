@@ -19,7 +19,6 @@
 #include <cassert>
 #include <cstring>
 
-#include "Random.hxx"
 #include "System.hxx"
 #include "CartFASC.hxx"
 
@@ -39,7 +38,7 @@ CartridgeFASC::~CartridgeFASC()
 void CartridgeFASC::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 256; ++i)
     myRAM[i] = random.next();
 
@@ -164,6 +163,7 @@ void CartridgeFASC::poke(uInt16 address, uInt8)
 void CartridgeFASC::bank(uInt16 bank)
 {
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentBank = bank;
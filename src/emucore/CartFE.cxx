@@ -23,6 +23,7 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 CartridgeFE::CartridgeFE(const uInt8* image)
+  : myLastBank(0)
 {
   // Copy the ROM image into my buffer
   for(uInt32 addr = 0; addr < 8192; ++addr)
@@ -65,8 +66,15 @@ void CartridgeFE::install(System& system)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 CartridgeFE::peek(uInt16 address)
 {
-  // The bank is determined by A13 of the processor
-  return myImage[(address & 0x0FFF) + (((address & 0x2000) == 0) ? 4096 : 0)];
+  // The bank is determined by A13 of the processor, so a bankswitch is
+  // counted whenever that changes
+  uInt16 bank = ((address & 0x2000) == 0) ? 1 : 0;
+  if(bank != myLastBank)
+  {
+    mySystem->counters().count(PerfCounters::BankSwitches);
+    myLastBank = bank;
+  }
+  return myImage[(address & 0x0FFF) + bank * 4096];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
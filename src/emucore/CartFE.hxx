@@ -150,6 +150,10 @@ class CartridgeFE : public Cartridge
   private:
     // The 8K ROM image of the cartridge
     uInt8 myImage[8192];
+
+    // The bank (selected by A13) of the last peek, used for counting
+    // bankswitches
+    uInt16 myLastBank;
 };
 
 #endif
@@ -119,6 +119,7 @@ void CartridgeMB::incbank()
 void CartridgeMB::bank(uInt16 bank)
 {
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   myCurrentBank = (bank - 1);
   incbank();
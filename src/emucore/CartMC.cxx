@@ -19,7 +19,6 @@
 #include <cassert>
 #include <cstring>
 
-#include "Random.hxx"
 #include "System.hxx"
 #include "CartMC.hxx"
 
@@ -46,7 +45,7 @@ CartridgeMC::~CartridgeMC()
 void CartridgeMC::reset()
 {
   // Initialize RAM with random values
-  class Random random;
+  Random& random = mySystem->randGenerator();
   for(uInt32 i = 0; i < 32768; ++i)
     myRAM[i] = random.next();
 }
@@ -170,6 +169,7 @@ void CartridgeMC::poke(uInt16 address, uInt8 value)
   if((address >= 0x003C) && (address <= 0x003F))
   {
     myCurrentBlock[address - 0x003C] = value;
+    mySystem->counters().count(PerfCounters::BankSwitches);
   }
   else
   {
@@ -124,6 +124,7 @@ void CartridgeSB::poke(uInt16 address, uInt8 value)
 void CartridgeSB::bank(uInt16 bank)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentBank = bank;
@@ -133,6 +133,7 @@ void CartridgeUA::poke(uInt16 address, uInt8 value)
 void CartridgeUA::bank(uInt16 bank)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentBank = bank;
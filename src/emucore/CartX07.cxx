@@ -117,6 +117,7 @@ void CartridgeX07::poke(uInt16 address, uInt8 value)
 void CartridgeX07::bank(uInt16 bank)
 { 
   if(myBankLocked) return;
+  mySystem->counters().count(PerfCounters::BankSwitches);
 
   // Remember what bank we're in
   myCurrentBank = (bank & 0x0f);
@@ -19,16 +19,16 @@
 #include <cassert>
 #include <iostream>
 #include <sstream>
-#include <fstream>
 
 #include "AtariVox.hxx"
 #include "Booster.hxx"
 #include "Cart.hxx"
 #include "Console.hxx"
 #include "Control.hxx"
+#include "DetectionCache.hxx"
 #include "Driving.hxx"
 #include "Event.hxx"
-#include "EventHandler.hxx"
+#include "Frontend.hxx"
 #include "Joystick.hxx"
 #include "Keyboard.hxx"
 #include "KidVid.hxx"
@@ -37,7 +37,6 @@
 #include "M6532.hxx"
 #include "Paddles.hxx"
 #include "Props.hxx"
-#include "PropsSet.hxx"
 #include "SaveKey.hxx"
 #include "Settings.hxx" 
 #include "Sound.hxx"
@@ -45,46 +44,37 @@
 #include "System.hxx"
 #include "TIA.hxx"
 #include "TrackBall.hxx"
-#include "FrameBuffer.hxx"
-#include "OSystem.hxx"
-#include "Menu.hxx"
-#include "CommandMenu.hxx"
 #include "Serializable.hxx"
-#include "Version.hxx"
-
-#ifdef DEBUGGER_SUPPORT
-  #include "Debugger.hxx"
-#endif
-
-#ifdef CHEATCODE_SUPPORT
-  #include "CheatManager.hxx"
-#endif
 
 #ifdef WII
 #include "wii_util.hxx"
 #endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Console::Console(OSystem* osystem, Cartridge* cart, const Properties& props)
-  : myOSystem(osystem),
+Console::Console(Cartridge* cart, const Properties& props,
+                 Settings& settings, Sound& sound, Event& event, uInt32 seed)
+  : myOSystem(0),
+    myFrontend(0),
+    mySettings(&settings),
+    mySound(&sound),
+    myEvent(&event),
     myProperties(props),
     myAVox(0),
     myDisplayFormat("NTSC"),
     myFramerate(60.0),
     myUserPaletteDefined(false)
+{
+  initialize(cart, seed);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::initialize(Cartridge* cart, uInt32 seed)
 {
   myControllers[0] = 0;
   myControllers[1] = 0;
   myTIA = 0;
   mySwitches = 0;
   mySystem = 0;
-  myEvent = 0;
-
-  // Attach the event subsystem to the current console
-  myEvent = myOSystem->eventHandler().event();
-
-  // Load user-defined palette for this ROM
-  loadUserPalette();
 
   // Create switches for the console
   mySwitches = new Switches(*myEvent, myProperties);
@@ -92,6 +82,9 @@ Console::Console(OSystem* osystem, Cartridge* cart, const Properties& props)
   // Construct the system and components
   mySystem = new System(13, 6);
 
+  // Each system has its own random number generator
+  mySystem->randGenerator().initSeed(seed);
+
   // The real controllers for this console will be added later
   // For now, we just add dummy joystick controllers, since autodetection
   // runs the emulation for a while, and this may interfere with 'smart'
@@ -103,17 +96,18 @@ Console::Console(OSystem* osystem, Cartridge* cart, const Properties& props)
   myControllers[1] = new Joystick(Controller::Right, *myEvent, *mySystem);
 
   M6502* m6502;
-  if(myOSystem->settings().getString("cpu") == "low")
+  if(mySettings->getString("cpu") == "low")
     m6502 = new M6502Low(1);
   else
     m6502 = new M6502High(1);
 #ifdef DEBUGGER_SUPPORT
-  m6502->attach(myOSystem->debugger());
+  if(myFrontend)
+    m6502->attach(myFrontend->debugger());
 #endif
 
   myCart = cart;
   myRiot = new M6532(*this);
-  myTIA  = new TIA(*this, myOSystem->sound(), myOSystem->settings());
+  myTIA  = new TIA(*this, *mySound, *mySettings);
 
   mySystem->attach(m6502);
   mySystem->attach(myRiot);
@@ -124,22 +118,31 @@ Console::Console(OSystem* osystem, Cartridge* cart, const Properties& props)
   string autodetected = "";
   myDisplayFormat = myProperties.get(Display_Format);
   if(myDisplayFormat == "AUTO-DETECT" ||
-     myOSystem->settings().getBool("rominfo"))
+     mySettings->getBool("rominfo"))
   {
-    // Run the system for 60 frames, looking for PAL scanline patterns
-    // We assume the first 30 frames are garbage, and only consider
-    // the second 30 (useful to get past SuperCharger BIOS)
-    // Unfortunately, this means we have to always enable 'fastscbios',
-    // since otherwise the BIOS loading will take over 250 frames!
-    mySystem->reset();
-    int palCount = 0;
-    for(int i = 0; i < 60; ++i)
+    // A ROM we've seen before doesn't need to be run again
+    const string& md5 = myProperties.get(Cartridge_MD5);
+    DetectionCache* cache = myFrontend && md5 != "" ?
+        &myFrontend->detectionCache() : 0;
+    if(!(cache && cache->getFormat(md5, myDisplayFormat)))
     {
-      myTIA->update();
-      if(i >= 30 && myTIA->scanlines() > 285)
-        ++palCount;
+      // Run the system for 60 frames, looking for PAL scanline patterns
+      // We assume the first 30 frames are garbage, and only consider
+      // the second 30 (useful to get past SuperCharger BIOS)
+      // Unfortunately, this means we have to always enable 'fastscbios',
+      // since otherwise the BIOS loading will take over 250 frames!
+      mySystem->reset();
+      int palCount = 0;
+      for(int i = 0; i < 60; ++i)
+      {
+        myTIA->update();
+        if(i >= 30 && myTIA->scanlines() > 285)
+          ++palCount;
+      }
+      myDisplayFormat = (palCount >= 15) ? "PAL" : "NTSC";
+      if(cache)
+        cache->setFormat(md5, myDisplayFormat);
     }
-    myDisplayFormat = (palCount >= 15) ? "PAL" : "NTSC";
     if(myProperties.get(Display_Format) == "AUTO-DETECT")
       autodetected = "*";
   }
@@ -183,15 +186,8 @@ Console::Console(OSystem* osystem, Cartridge* cart, const Properties& props)
     }
 #endif
 
-  const string& md5 = myProperties.get(Cartridge_MD5);
-
   // Add the real controllers for this system
-  setControllers(md5);
-
-  // Bumper Bash requires all 4 directions
-  bool allow = (md5 == "aa1c41f86ec44c0a44eb64c332ce08af" ||
-                md5 == "1bf503c724001b09be79c515ecfcbd03");
-  myOSystem->eventHandler().allowAllDirections(allow);
+  setControllers(myProperties.get(Cartridge_MD5));
 
   // Reset the system to its power-on state
   mySystem->reset();
@@ -201,7 +197,7 @@ Console::Console(OSystem* osystem, Cartridge* cart, const Properties& props)
   myConsoleInfo.CartMD5    = myProperties.get(Cartridge_MD5);
   myConsoleInfo.Control0   = myControllers[0]->about();
   myConsoleInfo.Control1   = myControllers[1]->about();
-  myConsoleInfo.BankSwitch = cart->about();
+  myConsoleInfo.BankSwitch = myCart->about();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -267,231 +263,12 @@ bool Console::load(Deserializer& in)
   return true;  // success
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Console::toggleFormat()
-{
-  string format, message;
-
-  if(myDisplayFormat.compare(0, 4, "NTSC") == 0)
-  {
-    if(myFramerate > 55.0)
-    {
-      format  = "PAL60";
-      message = "PAL palette (PAL60)";
-    }
-    else
-    {
-      format  = "PAL";
-      message = "PAL palette (PAL)";
-    }
-  }
-  else if(myDisplayFormat.compare(0, 3, "PAL") == 0)
-  {
-    if(myFramerate > 55.0)
-    {
-      format  = "SECAM";
-      message = "SECAM palette (SECAM60)";
-    }
-    else
-    {
-      format  = "SECAM";
-      message = "SECAM palette (SECAM)";
-    }
-  }
-  else if(myDisplayFormat.compare(0, 5, "SECAM") == 0)
-  {
-    if(myFramerate > 55.0)
-    {
-      format  = "NTSC";
-      message = "NTSC palette (NTSC)";
-    }
-    else
-    {
-      format  = "NTSC50";
-      message = "NTSC palette (NTSC50)";
-    }
-  }
-
-  myDisplayFormat = format;
-  myProperties.set(Display_Format, myDisplayFormat);
-  myOSystem->frameBuffer().showMessage(message);
-  setPalette(myOSystem->settings().getString("palette"));
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Console::toggleColorLoss()
-{
-  bool colorloss = !myOSystem->settings().getBool("colorloss");
-  myOSystem->settings().setBool("colorloss", colorloss);
-  setColorLossPalette(colorloss);
-  setPalette(myOSystem->settings().getString("palette"));
-
-  string message = string("PAL color-loss ") +
-                   (colorloss ? "enabled" : "disabled");
-  myOSystem->frameBuffer().showMessage(message);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Console::togglePalette()
-{
-  string palette, message;
-  palette = myOSystem->settings().getString("palette");
- 
-  if(palette == "standard")       // switch to z26
-  {
-    palette = "z26";
-    message = "Z26 palette";
-  }
-  else if(palette == "z26")       // switch to user or standard
-  {
-    // If we have a user-defined palette, it will come next in
-    // the sequence; otherwise loop back to the standard one
-    if(myUserPaletteDefined)
-    {
-      palette = "user";
-      message = "User-defined palette";
-    }
-    else
-    {
-      palette = "standard";
-      message = "Standard Stella palette";
-    }
-  }
-  else if(palette == "user")  // switch to standard
-  {
-    palette = "standard";
-    message = "Standard Stella palette";
-  }
-  else  // switch to standard mode if we get this far
-  {
-    palette = "standard";
-    message = "Standard Stella palette";
-  }
-
-  myOSystem->settings().setString("palette", palette);
-  myOSystem->frameBuffer().showMessage(message);
-
-  setPalette(palette);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Console::setPalette(const string& type)
-{
-  // Look at all the palettes, since we don't know which one is
-  // currently active
-  uInt32* palettes[3][3] = {
-    { &ourNTSCPalette[0],    &ourPALPalette[0],    &ourSECAMPalette[0]    },
-    { &ourNTSCPaletteZ26[0], &ourPALPaletteZ26[0], &ourSECAMPaletteZ26[0] },
-    { 0, 0, 0 }
-  };
-  if(myUserPaletteDefined)
-  {
-    palettes[2][0] = &ourUserNTSCPalette[0];
-    palettes[2][1] = &ourUserPALPalette[0];
-    palettes[2][2] = &ourUserSECAMPalette[0];
-  }
-
-  // See which format we should be using
-  int paletteNum = 0;
-  if(type == "standard")
-    paletteNum = 0;
-  else if(type == "z26")
-    paletteNum = 1;
-  else if(type == "user" && myUserPaletteDefined)
-    paletteNum = 2;
-
-  // Now consider the current display format
-  const uInt32* palette =
-    (myDisplayFormat.compare(0, 3, "PAL") == 0)   ? palettes[paletteNum][1] :
-    (myDisplayFormat.compare(0, 5, "SECAM") == 0) ? palettes[paletteNum][2] :
-     palettes[paletteNum][0];
-
-  myOSystem->frameBuffer().setTIAPalette(palette);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Console::togglePhosphor()
-{
-  const string& phosphor = myProperties.get(Display_Phosphor);
-  int blend = atoi(myProperties.get(Display_PPBlend).c_str());
-  bool enable;
-  if(phosphor == "YES")
-  {
-    myProperties.set(Display_Phosphor, "No");
-    enable = false;
-    myOSystem->frameBuffer().showMessage("Phosphor effect disabled");
-  }
-  else
-  {
-    myProperties.set(Display_Phosphor, "Yes");
-    enable = true;
-    myOSystem->frameBuffer().showMessage("Phosphor effect enabled");
-  }
-
-  myOSystem->frameBuffer().enablePhosphor(enable, blend);
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Console::setProperties(const Properties& props)
 {
   myProperties = props;
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool Console::initializeVideo(bool full)
-{
-  if(full)
-  {
-    string title = string("Stella ") + STELLA_VERSION +
-                   ": \"" + myProperties.get(Cartridge_Name) + "\"";
-    if(!myOSystem->frameBuffer().initialize(title,
-          myTIA->width() << 1, myTIA->height()))
-      return false;
-
-    myOSystem->frameBuffer().showFrameStats(
-      myOSystem->settings().getBool("stats"));
-  }
-
-  bool enable = myProperties.get(Display_Phosphor) == "YES";
-  int blend = atoi(myProperties.get(Display_PPBlend).c_str());
-  myOSystem->frameBuffer().enablePhosphor(enable, blend);
-  setColorLossPalette(myOSystem->settings().getBool("colorloss"));
-  setPalette(myOSystem->settings().getString("palette"));
-
-  // Set the correct framerate based on the format of the ROM
-  // This can be overridden by changing the framerate in the
-  // VideoDialog box or on the commandline, but it can't be saved
-  // (ie, framerate is now determined based on number of scanlines).
-  int framerate = myOSystem->settings().getInt("framerate");
-  if(framerate > 0) myFramerate = float(framerate);
-  myOSystem->setFramerate(myFramerate);
-
-  // Make sure auto-frame calculation is only enabled when necessary
-  myTIA->enableAutoFrame(framerate <= 0);
-
-  return true;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Console::initializeAudio()
-{
-  // Initialize the sound interface.
-  // The # of channels can be overridden in the AudioDialog box or on
-  // the commandline, but it can't be saved.
-  int framerate = myOSystem->settings().getInt("framerate");
-  if(framerate > 0) myFramerate = float(framerate);
-  const string& sound = myProperties.get(Cartridge_Sound);
-  uInt32 channels = (sound == "STEREO" ? 2 : 1);
-
-  myOSystem->sound().close();
-  myOSystem->sound().setChannels(channels);
-  myOSystem->sound().setFrameRate(myFramerate);
-  myOSystem->sound().open();
-
-  // Make sure auto-frame calculation is only enabled when necessary
-  myTIA->enableAutoFrame(framerate <= 0);
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 /* Original frying research and code by Fred Quimby.
    I've tried the following variations on this code:
@@ -518,82 +295,6 @@ void Console::fry() const
     mySystem->poke(ZPmem, mySystem->peek(ZPmem) & (uInt8)rand() % 256);
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Console::changeYStart(int direction)
-{
-  Int32 ystart = atoi(myProperties.get(Display_YStart).c_str());
-  ostringstream strval;
-  string message;
-
-  if(direction == +1)    // increase YStart
-  {
-    ystart++;
-    if(ystart > 64)
-    {
-      myOSystem->frameBuffer().showMessage("YStart at maximum");
-      return;
-    }
-  }
-  else if(direction == -1)  // decrease YStart
-  {
-    ystart--;
-    if(ystart < 0)
-    {
-      myOSystem->frameBuffer().showMessage("YStart at minimum");
-      return;
-    }
-  }
-  else
-    return;
-
-  strval << ystart;
-  myProperties.set(Display_YStart, strval.str());
-  myTIA->frameReset();
-  myOSystem->frameBuffer().refresh();
-
-  message = "YStart ";
-  message += strval.str();
-  myOSystem->frameBuffer().showMessage(message);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Console::changeHeight(int direction)
-{
-  Int32 height = atoi(myProperties.get(Display_Height).c_str());
-  ostringstream strval;
-  string message;
-
-  if(direction == +1)    // increase Height
-  {
-    height++;
-    if(height > 256)
-    {
-      myOSystem->frameBuffer().showMessage("Height at maximum");
-      return;
-    }
-  }
-  else if(direction == -1)  // decrease Height
-  {
-    height--;
-    if(height < 200)
-    {
-      myOSystem->frameBuffer().showMessage("Height at minimum");
-      return;
-    }
-  }
-  else
-    return;
-
-  strval << height;
-  myProperties.set(Display_Height, strval.str());
-  myTIA->frameReset();
-  initializeVideo();  // takes care of refreshing the screen
-
-  message = "Height ";
-  message += strval.str();
-  myOSystem->frameBuffer().showMessage(message);
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Console::setControllers(const string& rommd5)
 {
@@ -617,7 +318,6 @@ void Console::setControllers(const string& rommd5)
 
   // Also check if we should swap the paddles plugged into a jack
   bool swapPaddles = myProperties.get(Controller_SwapPaddles) == "YES";
-  Paddles::setMouseIsPaddle(-1);  // Reset to defaults
 
   // Construct left controller
   if(left == "BOOSTERGRIP")
@@ -696,16 +396,19 @@ void Console::setControllers(const string& rommd5)
   }
   else if(right == "ATARIVOX")
   {
-    const string& eepromfile = myOSystem->eepromDir() + BSPF_PATH_SEPARATOR +
-                               "atarivox_eeprom.dat";
+    // Without an OSystem there's no serial port or EEPROM directory,
+    // so the EEPROM contents are only kept in memory
+    const string& eepromfile = myFrontend ? myFrontend->eepromDir() +
+                               BSPF_PATH_SEPARATOR + "atarivox_eeprom.dat" : "";
+    SerialPort& port = myFrontend ? myFrontend->serialPort() : myNullSerialPort;
     myControllers[rightPort] = myAVox =
-      new AtariVox(Controller::Right, *myEvent, *mySystem, myOSystem->serialPort(),
-                   myOSystem->settings().getString("avoxport"), eepromfile);
+      new AtariVox(Controller::Right, *myEvent, *mySystem, port,
+                   mySettings->getString("avoxport"), eepromfile);
   }
   else if(right == "SAVEKEY")
   {
-    const string& eepromfile = myOSystem->eepromDir() + BSPF_PATH_SEPARATOR +
-                        "savekey_eeprom.dat";
+    const string& eepromfile = myFrontend ? myFrontend->eepromDir() +
+                        BSPF_PATH_SEPARATOR + "savekey_eeprom.dat" : "";
     myControllers[rightPort] = new SaveKey(Controller::Right, *myEvent, *mySystem,
                                            eepromfile);
   }
@@ -717,79 +420,47 @@ void Console::setControllers(const string& rommd5)
   {
     myControllers[rightPort] = new Joystick(Controller::Right, *myEvent, *mySystem);
   }
-}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Console::toggleTIABit(TIA::TIABit bit, const string& bitname, bool show) const
-{
-  bool result = myTIA->toggleBit(bit);
-  string message = bitname + (result ? " enabled" : " disabled");
-  myOSystem->frameBuffer().showMessage(message);
-}
+  setPaddleSpeed(mySettings->getInt("pspeed"));
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Console::enableBits(bool enable) const
-{
-  myTIA->enableBits(enable);
-  string message = string("TIA bits") + (enable ? " enabled" : " disabled");
-  myOSystem->frameBuffer().showMessage(message);
+  // The mouse paddle is chosen by the user; otherwise the paddle
+  // controllers pick their own default
+  int mpaddle = mySettings->getInt("mpaddle");
+  if(mpaddle >= 0)
+    setPaddleMode(mpaddle);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Console::loadUserPalette()
+const uInt32* Console::palette(const string& type) const
 {
-  const string& palette = myOSystem->paletteFile();
-  ifstream in(palette.c_str(), ios::binary);
-  if(!in)
-    return;
-
-  // Make sure the contains enough data for the NTSC, PAL and SECAM palettes
-  // This means 128 colours each for NTSC and PAL, at 3 bytes per pixel
-  // and 8 colours for SECAM at 3 bytes per pixel
-  in.seekg(0, ios::end);
-  streampos length = in.tellg();
-  in.seekg(0, ios::beg);
-  if(length < 128 * 3 * 2 + 8 * 3)
-  {
-    in.close();
-    cerr << "ERROR: invalid palette file " << palette << endl;
-    return;
-  }
-
-  // Now that we have valid data, create the user-defined palettes
-  uInt8 pixbuf[3];  // Temporary buffer for one 24-bit pixel
-
-  for(int i = 0; i < 128; i++)  // NTSC palette
-  {
-    in.read((char*)pixbuf, 3);
-    uInt32 pixel = ((int)pixbuf[0] << 16) + ((int)pixbuf[1] << 8) + (int)pixbuf[2];
-    ourUserNTSCPalette[(i<<1)] = pixel;
-  }
-  for(int i = 0; i < 128; i++)  // PAL palette
+  // Look at all the palettes, since we don't know which one is
+  // currently active
+  const uInt32* palettes[3][3] = {
+    { &ourNTSCPalette[0],    &ourPALPalette[0],    &ourSECAMPalette[0]    },
+    { &ourNTSCPaletteZ26[0], &ourPALPaletteZ26[0], &ourSECAMPaletteZ26[0] },
+    { 0, 0, 0 }
+  };
+  if(myUserPaletteDefined)
   {
-    in.read((char*)pixbuf, 3);
-    uInt32 pixel = ((int)pixbuf[0] << 16) + ((int)pixbuf[1] << 8) + (int)pixbuf[2];
-    ourUserPALPalette[(i<<1)] = pixel;
+    palettes[2][0] = &ourUserNTSCPalette[0];
+    palettes[2][1] = &ourUserPALPalette[0];
+    palettes[2][2] = &ourUserSECAMPalette[0];
   }
 
-  uInt32 secam[16];  // All 8 24-bit pixels, plus 8 colorloss pixels
-  for(int i = 0; i < 8; i++)    // SECAM palette
-  {
-    in.read((char*)pixbuf, 3);
-    uInt32 pixel = ((int)pixbuf[0] << 16) + ((int)pixbuf[1] << 8) + (int)pixbuf[2];
-    secam[(i<<1)]   = pixel;
-    secam[(i<<1)+1] = 0;
-  }
-  uInt32* ptr = ourUserSECAMPalette;
-  for(int i = 0; i < 16; ++i)
-  {
-    uInt32* s = secam;
-    for(int j = 0; j < 16; ++j)
-      *ptr++ = *s++;
-  }
+  // See which format we should be using
+  int paletteNum = 0;
+  if(type == "standard")
+    paletteNum = 0;
+  else if(type == "z26")
+    paletteNum = 1;
+  else if(type == "user" && myUserPaletteDefined)
+    paletteNum = 2;
 
-  in.close();
-  myUserPaletteDefined = true;
+  // Now consider the current display format
+  return
+    (myDisplayFormat.compare(0, 3, "PAL") == 0)   ? palettes[paletteNum][1] :
+    (myDisplayFormat.compare(0, 5, "SECAM") == 0) ? palettes[paletteNum][2] :
+     palettes[paletteNum][0];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -839,8 +510,25 @@ void Console::setColorLossPalette(bool loss)
 void Console::setFramerate(float framerate)
 {
   myFramerate = framerate;
-  myOSystem->setFramerate(framerate);
-  myOSystem->sound().setFrameRate(framerate);
+  if(myFrontend)
+    myFrontend->setFramerate(framerate);
+  mySound->setFrameRate(framerate);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::setPaddleMode(int number)
+{
+  for(int i = 0; i < 2; ++i)
+    if(myControllers[i]->type() == Controller::Paddles)
+      static_cast<Paddles*>(myControllers[i])->setMouseIsPaddle(number);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::setPaddleSpeed(int speed)
+{
+  for(int i = 0; i < 2; ++i)
+    if(myControllers[i]->type() == Controller::Paddles)
+      static_cast<Paddles*>(myControllers[i])->setDigitalSpeed(speed);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1070,7 +758,10 @@ uInt32 Console::ourUserSECAMPalette[256] = { 0 }; // filled from external file
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Console::Console(const Console& console)
-  : myOSystem(console.myOSystem)
+  : myOSystem(console.myOSystem),
+    myFrontend(console.myFrontend),
+    mySettings(console.mySettings),
+    mySound(console.mySound)
 {
   // TODO: Write this method
   assert(false);
@@ -22,6 +22,9 @@
 class Console;
 class Controller;
 class Event;
+class Frontend;
+class Settings;
+class Sound;
 class Switches;
 class System;
 class TIA;
@@ -33,6 +36,7 @@ class TIA;
 #include "Cart.hxx"
 #include "M6532.hxx"
 #include "AtariVox.hxx"
+#include "SerialPort.hxx"
 #include "Serializable.hxx"
 
 /**
@@ -68,6 +72,23 @@ class Console : public Serializable
     */
     Console(OSystem* osystem, Cartridge* cart, const Properties& props);
 
+    /**
+      Create a new console which isn't attached to an OSystem (no
+      framebuffer, event handler or debugger).  This is used by the
+      headless core library, where the caller supplies the settings,
+      sound device and event object directly.
+
+      @param cart      The cartridge to use with this console
+      @param props     The properties for the cartridge
+      @param settings  The settings object to use
+      @param sound     The sound device the TIA will send its output to
+      @param event     The event object the controllers and switches read
+      @param seed      The seed for the random number generator; the
+                       default makes every run of a ROM start the same
+    */
+    Console(Cartridge* cart, const Properties& props,
+            Settings& settings, Sound& sound, Event& event, uInt32 seed = 0);
+
     /**
       Create a new console object by copying another one
 
@@ -195,6 +216,14 @@ class Console : public Serializable
     */
     void setPalette(const string& palette);
 
+    /**
+      Answers the palette with the given name for the current display
+      format, mapping each TIA framebuffer value to a 32-bit pixel.
+
+      @param palette  The palette to look up ('standard', 'z26' or 'user')
+    */
+    const uInt32* palette(const string& palette) const;
+
     /**
       Toggles phosphor effect.
     */
@@ -253,6 +282,18 @@ class Console : public Serializable
     */
     float getFramerate() const { return myFramerate; }
 
+    /**
+      Sets the mouse to emulate the given paddle (0 - 3) for any paddle
+      controllers plugged into this console.
+    */
+    void setPaddleMode(int number);
+
+    /**
+      Sets the speed of digital paddle movement for any paddle
+      controllers plugged into this console.
+    */
+    void setPaddleSpeed(int speed);
+
     /**
       Toggles the TIA bit specified in the method name.
     */
@@ -268,6 +309,16 @@ class Console : public Serializable
     AtariVox* atariVox() { return myAVox; }
 
   private:
+    /**
+      Creates the system and all devices, and runs display format
+      autodetection.  This is shared by all constructors, and expects
+      myEvent, mySettings and mySound to already be set.
+
+      @param cart  The cartridge to use with this console
+      @param seed  The seed for the random number generator
+    */
+    void initialize(Cartridge* cart, uInt32 seed);
+
     /**
       Adds the left and right controllers to the console
     */
@@ -294,9 +345,19 @@ class Console : public Serializable
     const uInt32* getPalette(int direction) const;
 
   private:
-    // Pointer to the osystem object
+    // Pointer to the osystem object (NULL when running headless)
     OSystem* myOSystem;
 
+    // The part of the osystem the emulation core uses (NULL when headless)
+    Frontend* myFrontend;
+
+    // Pointers to the settings and sound objects used by the core
+    Settings* mySettings;
+    Sound* mySound;
+
+    // Serial port used by an AtariVox when there's no OSystem to provide one
+    SerialPort myNullSerialPort;
+
     // Pointers to the left and right controllers
     Controller* myControllers[2];
 
@@ -0,0 +1,402 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <sstream>
+#include <fstream>
+
+#include "Console.hxx"
+#include "EventHandler.hxx"
+#include "FrameBuffer.hxx"
+#include "OSystem.hxx"
+#include "Settings.hxx"
+#include "Sound.hxx"
+#include "TIA.hxx"
+#include "Version.hxx"
+
+// The Console methods in this file (including the OSystem constructor) deal
+// with events, onscreen messages, palette and video mode changes, and
+// require an OSystem with a valid framebuffer.
+// They're kept out of Console.cxx so the emulation core can be linked
+// without the FrameBuffer and EventHandler classes.
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Console::Console(OSystem* osystem, Cartridge* cart, const Properties& props)
+  : myOSystem(osystem),
+    myFrontend(osystem),
+    mySettings(&osystem->settings()),
+    mySound(&osystem->sound()),
+    myProperties(props),
+    myAVox(0),
+    myDisplayFormat("NTSC"),
+    myFramerate(60.0),
+    myUserPaletteDefined(false)
+{
+  // Attach the event subsystem to the current console
+  myEvent = myOSystem->eventHandler().event();
+
+  // Load user-defined palette for this ROM
+  loadUserPalette();
+
+  // Seed the random number generator from the high-resolution timer
+  initialize(cart, myOSystem->getTicks());
+
+  // Bumper Bash requires all 4 directions
+  const string& md5 = myProperties.get(Cartridge_MD5);
+  bool allow = (md5 == "aa1c41f86ec44c0a44eb64c332ce08af" ||
+                md5 == "1bf503c724001b09be79c515ecfcbd03");
+  myOSystem->eventHandler().allowAllDirections(allow);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::loadUserPalette()
+{
+  const string& palette = myOSystem->paletteFile();
+  ifstream in(palette.c_str(), ios::binary);
+  if(!in)
+    return;
+
+  // Make sure the contains enough data for the NTSC, PAL and SECAM palettes
+  // This means 128 colours each for NTSC and PAL, at 3 bytes per pixel
+  // and 8 colours for SECAM at 3 bytes per pixel
+  in.seekg(0, ios::end);
+  streampos length = in.tellg();
+  in.seekg(0, ios::beg);
+  if(length < 128 * 3 * 2 + 8 * 3)
+  {
+    in.close();
+    cerr << "ERROR: invalid palette file " << palette << endl;
+    return;
+  }
+
+  // Now that we have valid data, create the user-defined palettes
+  uInt8 pixbuf[3];  // Temporary buffer for one 24-bit pixel
+
+  for(int i = 0; i < 128; i++)  // NTSC palette
+  {
+    in.read((char*)pixbuf, 3);
+    uInt32 pixel = ((int)pixbuf[0] << 16) + ((int)pixbuf[1] << 8) + (int)pixbuf[2];
+    ourUserNTSCPalette[(i<<1)] = pixel;
+  }
+  for(int i = 0; i < 128; i++)  // PAL palette
+  {
+    in.read((char*)pixbuf, 3);
+    uInt32 pixel = ((int)pixbuf[0] << 16) + ((int)pixbuf[1] << 8) + (int)pixbuf[2];
+    ourUserPALPalette[(i<<1)] = pixel;
+  }
+
+  uInt32 secam[16];  // All 8 24-bit pixels, plus 8 colorloss pixels
+  for(int i = 0; i < 8; i++)    // SECAM palette
+  {
+    in.read((char*)pixbuf, 3);
+    uInt32 pixel = ((int)pixbuf[0] << 16) + ((int)pixbuf[1] << 8) + (int)pixbuf[2];
+    secam[(i<<1)]   = pixel;
+    secam[(i<<1)+1] = 0;
+  }
+  uInt32* ptr = ourUserSECAMPalette;
+  for(int i = 0; i < 16; ++i)
+  {
+    uInt32* s = secam;
+    for(int j = 0; j < 16; ++j)
+      *ptr++ = *s++;
+  }
+
+  in.close();
+  myUserPaletteDefined = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::toggleFormat()
+{
+  string format, message;
+
+  if(myDisplayFormat.compare(0, 4, "NTSC") == 0)
+  {
+    if(myFramerate > 55.0)
+    {
+      format  = "PAL60";
+      message = "PAL palette (PAL60)";
+    }
+    else
+    {
+      format  = "PAL";
+      message = "PAL palette (PAL)";
+    }
+  }
+  else if(myDisplayFormat.compare(0, 3, "PAL") == 0)
+  {
+    if(myFramerate > 55.0)
+    {
+      format  = "SECAM";
+      message = "SECAM palette (SECAM60)";
+    }
+    else
+    {
+      format  = "SECAM";
+      message = "SECAM palette (SECAM)";
+    }
+  }
+  else if(myDisplayFormat.compare(0, 5, "SECAM") == 0)
+  {
+    if(myFramerate > 55.0)
+    {
+      format  = "NTSC";
+      message = "NTSC palette (NTSC)";
+    }
+    else
+    {
+      format  = "NTSC50";
+      message = "NTSC palette (NTSC50)";
+    }
+  }
+
+  myDisplayFormat = format;
+  myProperties.set(Display_Format, myDisplayFormat);
+  myOSystem->frameBuffer().showMessage(message);
+  setPalette(myOSystem->settings().getString("palette"));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::toggleColorLoss()
+{
+  bool colorloss = !myOSystem->settings().getBool("colorloss");
+  myOSystem->settings().setBool("colorloss", colorloss);
+  setColorLossPalette(colorloss);
+  setPalette(myOSystem->settings().getString("palette"));
+
+  string message = string("PAL color-loss ") +
+                   (colorloss ? "enabled" : "disabled");
+  myOSystem->frameBuffer().showMessage(message);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::togglePalette()
+{
+  string palette, message;
+  palette = myOSystem->settings().getString("palette");
+ 
+  if(palette == "standard")       // switch to z26
+  {
+    palette = "z26";
+    message = "Z26 palette";
+  }
+  else if(palette == "z26")       // switch to user or standard
+  {
+    // If we have a user-defined palette, it will come next in
+    // the sequence; otherwise loop back to the standard one
+    if(myUserPaletteDefined)
+    {
+      palette = "user";
+      message = "User-defined palette";
+    }
+    else
+    {
+      palette = "standard";
+      message = "Standard Stella palette";
+    }
+  }
+  else if(palette == "user")  // switch to standard
+  {
+    palette = "standard";
+    message = "Standard Stella palette";
+  }
+  else  // switch to standard mode if we get this far
+  {
+    palette = "standard";
+    message = "Standard Stella palette";
+  }
+
+  myOSystem->settings().setString("palette", palette);
+  myOSystem->frameBuffer().showMessage(message);
+
+  setPalette(palette);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::setPalette(const string& type)
+{
+  myOSystem->frameBuffer().setTIAPalette(palette(type));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::togglePhosphor()
+{
+  const string& phosphor = myProperties.get(Display_Phosphor);
+  int blend = atoi(myProperties.get(Display_PPBlend).c_str());
+  bool enable;
+  if(phosphor == "YES")
+  {
+    myProperties.set(Display_Phosphor, "No");
+    enable = false;
+    myOSystem->frameBuffer().showMessage("Phosphor effect disabled");
+  }
+  else
+  {
+    myProperties.set(Display_Phosphor, "Yes");
+    enable = true;
+    myOSystem->frameBuffer().showMessage("Phosphor effect enabled");
+  }
+
+  myOSystem->frameBuffer().enablePhosphor(enable, blend);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Console::initializeVideo(bool full)
+{
+  if(full)
+  {
+    string title = string("Stella ") + STELLA_VERSION +
+                   ": \"" + myProperties.get(Cartridge_Name) + "\"";
+    if(!myOSystem->frameBuffer().initialize(title,
+          myTIA->width() << 1, myTIA->height()))
+      return false;
+
+    myOSystem->frameBuffer().showFrameStats(
+      myOSystem->settings().getBool("stats"));
+  }
+
+  bool enable = myProperties.get(Display_Phosphor) == "YES";
+  int blend = atoi(myProperties.get(Display_PPBlend).c_str());
+  myOSystem->frameBuffer().enablePhosphor(enable, blend);
+  setColorLossPalette(myOSystem->settings().getBool("colorloss"));
+  setPalette(myOSystem->settings().getString("palette"));
+
+  // Set the correct framerate based on the format of the ROM
+  // This can be overridden by changing the framerate in the
+  // VideoDialog box or on the commandline, but it can't be saved
+  // (ie, framerate is now determined based on number of scanlines).
+  int framerate = myOSystem->settings().getInt("framerate");
+  if(framerate > 0) myFramerate = float(framerate);
+  myOSystem->setFramerate(myFramerate);
+
+  // Make sure auto-frame calculation is only enabled when necessary
+  myTIA->enableAutoFrame(framerate <= 0);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::initializeAudio()
+{
+  // Initialize the sound interface.
+  // The # of channels can be overridden in the AudioDialog box or on
+  // the commandline, but it can't be saved.
+  int framerate = myOSystem->settings().getInt("framerate");
+  if(framerate > 0) myFramerate = float(framerate);
+  const string& sound = myProperties.get(Cartridge_Sound);
+  uInt32 channels = (sound == "STEREO" ? 2 : 1);
+
+  myOSystem->sound().close();
+  myOSystem->sound().setChannels(channels);
+  myOSystem->sound().setFrameRate(myFramerate);
+  myOSystem->sound().open();
+
+  // Make sure auto-frame calculation is only enabled when necessary
+  myTIA->enableAutoFrame(framerate <= 0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::changeYStart(int direction)
+{
+  Int32 ystart = atoi(myProperties.get(Display_YStart).c_str());
+  ostringstream strval;
+  string message;
+
+  if(direction == +1)    // increase YStart
+  {
+    ystart++;
+    if(ystart > 64)
+    {
+      myOSystem->frameBuffer().showMessage("YStart at maximum");
+      return;
+    }
+  }
+  else if(direction == -1)  // decrease YStart
+  {
+    ystart--;
+    if(ystart < 0)
+    {
+      myOSystem->frameBuffer().showMessage("YStart at minimum");
+      return;
+    }
+  }
+  else
+    return;
+
+  strval << ystart;
+  myProperties.set(Display_YStart, strval.str());
+  myTIA->frameReset();
+  myOSystem->frameBuffer().refresh();
+
+  message = "YStart ";
+  message += strval.str();
+  myOSystem->frameBuffer().showMessage(message);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::changeHeight(int direction)
+{
+  Int32 height = atoi(myProperties.get(Display_Height).c_str());
+  ostringstream strval;
+  string message;
+
+  if(direction == +1)    // increase Height
+  {
+    height++;
+    if(height > 256)
+    {
+      myOSystem->frameBuffer().showMessage("Height at maximum");
+      return;
+    }
+  }
+  else if(direction == -1)  // decrease Height
+  {
+    height--;
+    if(height < 200)
+    {
+      myOSystem->frameBuffer().showMessage("Height at minimum");
+      return;
+    }
+  }
+  else
+    return;
+
+  strval << height;
+  myProperties.set(Display_Height, strval.str());
+  myTIA->frameReset();
+  initializeVideo();  // takes care of refreshing the screen
+
+  message = "Height ";
+  message += strval.str();
+  myOSystem->frameBuffer().showMessage(message);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::toggleTIABit(TIA::TIABit bit, const string& bitname, bool show) const
+{
+  bool result = myTIA->toggleBit(bit);
+  string message = bitname + (result ? " enabled" : " disabled");
+  myOSystem->frameBuffer().showMessage(message);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Console::enableBits(bool enable) const
+{
+  myTIA->enableBits(enable);
+  string message = string("TIA bits") + (enable ? " enabled" : " disabled");
+  myOSystem->frameBuffer().showMessage(message);
+}
@@ -66,6 +66,11 @@ class Controller : public Serializable
   */
   friend class RiotDebug;
 
+  /**
+    The rewind buffer records and replays the pin state of each frame
+  */
+  friend class RewindBuffer;
+
   public:
     /**
       Enumeration of the controller jacks
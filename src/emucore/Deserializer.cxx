@@ -16,10 +16,17 @@
 // $Id: Deserializer.cxx,v 1.15 2009-01-01 18:13:35 stephena Exp $
 //============================================================================
 
+#include <fstream>
+
 #include "Deserializer.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Deserializer::Deserializer(void)
+  : myData(0),
+    mySize(0),
+    myPos(0),
+    myFileData(0),
+    myIsOpen(false)
 {
 }
 
@@ -33,62 +40,72 @@ Deserializer::~Deserializer(void)
 bool Deserializer::open(const string& fileName)
 {
   close();
-  myStream.open(fileName.c_str(), ios::in | ios::binary);
 
-  return isOpen();
+  // State files are small, so read the whole thing in one operation
+  ifstream in(fileName.c_str(), ios::in | ios::binary);
+  if(!in)
+    return false;
+
+  in.seekg(0, ios::end);
+  streampos length = in.tellg();
+  in.seekg(0, ios::beg);
+  if(length < 0)
+    return false;
+
+  mySize = (uInt32) length;
+  myFileData = new uInt8[mySize > 0 ? mySize : 1];
+  in.read((char*)myFileData, (streamsize)mySize);
+  if(in.bad())
+  {
+    close();
+    return false;
+  }
+  in.close();
+
+  myData   = myFileData;
+  myIsOpen = true;
+
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Deserializer::close(void)
+bool Deserializer::open(const uInt8* data, uInt32 size)
 {
-  myStream.close();
-  myStream.clear();
-}
+  close();
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool Deserializer::isOpen(void)
-{
-  return myStream.is_open();
+  myData   = data;
+  mySize   = size;
+  myIsOpen = true;
+
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-char Deserializer::getByte(void)
+void Deserializer::close(void)
 {
-  if(myStream.eof())
-    throw "Deserializer: end of file";
-
-  char buf[1];
-  myStream.read(buf, 1);
-
-  return buf[0];
+  delete[] myFileData;
+  myFileData = 0;
+  myData = 0;
+  mySize = myPos = 0;
+  myIsOpen = false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int Deserializer::getInt(void)
+bool Deserializer::isOpen(void)
 {
-  if(myStream.eof())
-    throw "Deserializer: end of file";
-
-  int val = 0;
-  unsigned char buf[4];
-  myStream.read((char*)buf, 4);
-  for(int i = 0; i < 4; ++i)
-    val += (int)(buf[i]) << (i<<3);
-
-  return val;
+  return myIsOpen;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string Deserializer::getString(void)
 {
-  int len = getInt();
-  string str;
-  str.resize((string::size_type)len);
-  myStream.read(&str[0], (streamsize)len);
-
-  if(myStream.bad())
+  uInt32 len = (uInt32) getInt();
+  if(len > mySize - myPos)
     throw "Deserializer: file read failed";
 
+  string str((const char*)myData + myPos, len);
+  myPos += len;
+
   return str;
 }
 
@@ -27,6 +27,10 @@
   deserialized from an input binary file in a system-independent
   way.
 
+  The data can either come from a file (which is read into memory
+  completely when opened), or directly from a block of memory such as
+  the one filled in by a Serializer.
+
   All bytes and ints should be cast to their appropriate data type upon
   method return.
 
@@ -39,8 +43,8 @@ class Deserializer
     /**
       Creates a new Deserializer device.
 
-      Open must be called with a valid file before this Deserializer can
-      be used.
+      Open must be called with a valid file or buffer before this
+      Deserializer can be used.
     */
     Deserializer(void);
 
@@ -59,6 +63,16 @@ class Deserializer
     */
     bool open(const string& fileName);
 
+    /**
+      Uses the given memory for input.  The data isn't copied, so it
+      must remain valid until this Deserializer is closed or reopened.
+
+      @param data  The serialized data (normally from Serializer::data())
+      @param size  The number of bytes of serialized data
+      @return Always true
+    */
+    bool open(const uInt8* data, uInt32 size);
+
     /**
       Closes the current input stream.
     */
@@ -69,19 +83,57 @@ class Deserializer
     */
     bool isOpen(void);
 
+    /**
+      Moves back to the start of the data, so the same state can be
+      loaded again.
+    */
+    void reset(void) { myPos = 0; }
+
+    /**
+      Moves to the given position in the data, so reading can start
+      anywhere in a file that has an index of its contents.
+
+      @param pos  The offset from the start of the data (clamped to size())
+    */
+    void seek(uInt32 pos) { myPos = pos < mySize ? pos : mySize; }
+
+    /**
+      Get the current position in the data.
+    */
+    uInt32 position(void) const { return myPos; }
+
+    /**
+      Get the total number of bytes of data.
+    */
+    uInt32 size(void) const { return mySize; }
+
     /**
       Reads a byte value (8-bit) from the current input stream.
 
       @result The char value which has been read from the stream.
     */
-    char getByte(void);
+    char getByte(void)
+    {
+      if(myPos >= mySize)
+        throw "Deserializer: end of file";
+
+      return (char) myData[myPos++];
+    }
 
     /**
       Reads an int value (32-bit) from the current input stream.
 
       @result The int value which has been read from the stream.
     */
-    int getInt(void);
+    int getInt(void)
+    {
+      if(myPos + 4 > mySize)
+        throw "Deserializer: end of file";
+
+      const uInt8* buf = myData + myPos;
+      myPos += 4;
+      return (int)(buf[0] | (buf[1] << 8) | (buf[2] << 16) | (buf[3] << 24));
+    }
 
     /**
       Reads a string from the current input stream.
@@ -98,8 +150,20 @@ class Deserializer
     bool getBool(void);
 
   private:
-    // The stream to get the deserialized data from.
-    fstream myStream;
+    // Copy constructor and assignment operator not supported
+    Deserializer(const Deserializer&);
+    Deserializer& operator = (const Deserializer&);
+
+  private:
+    // The data being deserialized, and the current position within it
+    const uInt8* myData;
+    uInt32 mySize;
+    uInt32 myPos;
+
+    // The contents of the file, when reading from a file
+    uInt8* myFileData;
+
+    bool myIsOpen;
 
     enum {
       TruePattern  = 0xfe,
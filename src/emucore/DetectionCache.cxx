@@ -0,0 +1,138 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <fstream>
+#include <sstream>
+
+#include "DetectionCache.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+DetectionCache::DetectionCache()
+  : myIsDirty(false)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+DetectionCache::~DetectionCache()
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DetectionCache::load(const string& filename)
+{
+  ifstream in(filename.c_str(), ios::in);
+  if(!in)
+    return false;
+
+  string line;
+  while(getline(in, line))
+  {
+    istringstream buf(line);
+    string md5;
+    Entry entry;
+
+    // Skip any line that isn't complete
+    if(!(buf >> md5 >> entry.format))
+      continue;
+    getline(buf >> ws, entry.cartType);
+
+    // Any entries already in memory are more recent than those on disk
+    if(md5.length() == 32 && myEntries.find(md5) == myEntries.end())
+      myEntries.insert(make_pair(md5, entry));
+  }
+
+  in.close();
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DetectionCache::save(const string& filename)
+{
+  if(!myIsDirty)
+    return true;
+
+  ofstream out(filename.c_str(), ios::out);
+  if(!out)
+    return false;
+
+  // An undetected format is written as '-', so the line can still be parsed
+  EntryMap::const_iterator iter;
+  for(iter = myEntries.begin(); iter != myEntries.end(); ++iter)
+  {
+    const Entry& entry = iter->second;
+    out << iter->first << " "
+        << (entry.format != "" ? entry.format : "-") << " "
+        << entry.cartType << endl;
+  }
+
+  out.close();
+  myIsDirty = false;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DetectionCache::getCartType(const string& md5, string& type) const
+{
+  EntryMap::const_iterator iter = myEntries.find(md5);
+  if(iter == myEntries.end() || iter->second.cartType == "")
+    return false;
+
+  type = iter->second.cartType;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DetectionCache::getFormat(const string& md5, string& format) const
+{
+  EntryMap::const_iterator iter = myEntries.find(md5);
+  if(iter == myEntries.end() || iter->second.format == "" ||
+     iter->second.format == "-")
+    return false;
+
+  format = iter->second.format;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DetectionCache::setCartType(const string& md5, const string& type)
+{
+  Entry& entry = myEntries[md5];
+  if(entry.cartType != type)
+  {
+    entry.cartType = type;
+    myIsDirty = true;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DetectionCache::setFormat(const string& md5, const string& format)
+{
+  Entry& entry = myEntries[md5];
+  if(entry.format != format)
+  {
+    entry.format = format;
+    myIsDirty = true;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DetectionCache::clear()
+{
+  myEntries.clear();
+  myIsDirty = true;
+}
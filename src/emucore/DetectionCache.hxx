@@ -0,0 +1,118 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef DETECTION_CACHE_HXX
+#define DETECTION_CACHE_HXX
+
+#include <map>
+
+#include "bspf.hxx"
+
+/**
+  This class remembers the results of the expensive autodetection
+  done when a ROM is first opened (the cartridge bankswitch type and the
+  NTSC/PAL display format), keyed by the MD5 of the ROM image.  Subsequent
+  opens of the same ROM can then skip the byte-pattern scan of the image
+  and the 60 frames of emulation otherwise needed to detect the format.
+
+  The cache is stored as a plain text file, one ROM per line:
+
+    <md5> <display format> <cartridge type>
+
+  The cartridge type is last since some types contain spaces.
+
+  @author  Stella team
+  @version $Id$
+*/
+class DetectionCache
+{
+  public:
+    /**
+      The results of autodetection for a single ROM.  Empty strings
+      indicate that this part of the entry hasn't been detected yet.
+    */
+    struct Entry {
+      string format;
+      string cartType;
+    };
+
+  public:
+    DetectionCache();
+    virtual ~DetectionCache();
+
+  public:
+    /**
+      Load the cache from the given file, merging with any entries
+      already present.
+
+      @param filename  Full pathname of the cache file
+      @return  False if the file couldn't be opened, else true
+    */
+    bool load(const string& filename);
+
+    /**
+      Save the cache to the given file, if it has changed since it
+      was last loaded or saved.
+
+      @param filename  Full pathname of the cache file
+      @return  False if the file couldn't be written, else true
+    */
+    bool save(const string& filename);
+
+    /**
+      Get the cached cartridge type for the given ROM.
+
+      @param md5   The MD5 of the ROM image
+      @param type  Receives the cartridge type, if one was cached
+      @return  True if a cartridge type was found, else false
+    */
+    bool getCartType(const string& md5, string& type) const;
+
+    /**
+      Get the cached display format for the given ROM.
+
+      @param md5     The MD5 of the ROM image
+      @param format  Receives the display format, if one was cached
+      @return  True if a display format was found, else false
+    */
+    bool getFormat(const string& md5, string& format) const;
+
+    /**
+      Remember the detected cartridge type for the given ROM.
+    */
+    void setCartType(const string& md5, const string& type);
+
+    /**
+      Remember the detected display format for the given ROM.
+    */
+    void setFormat(const string& md5, const string& format);
+
+    /**
+      Forget everything in the cache.
+    */
+    void clear();
+
+  private:
+    typedef map<string, Entry> EntryMap;
+    EntryMap myEntries;
+
+    // Indicates whether the cache needs to be written back to disk
+    bool myIsDirty;
+};
+
+#endif
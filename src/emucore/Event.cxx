@@ -16,9 +16,6 @@
 // $Id: Event.cxx,v 1.16 2009-01-01 18:13:35 stephena Exp $
 //============================================================================
 
-#include "OSystem.hxx"
-#include "Console.hxx"
-#include "Control.hxx"
 
 #include "Event.hxx"
 
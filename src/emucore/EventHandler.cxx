@@ -30,8 +30,6 @@
 #include "Launcher.hxx"
 #include "Menu.hxx"
 #include "OSystem.hxx"
-#include "Joystick.hxx"
-#include "Paddles.hxx"
 #include "PropsSet.hxx"
 #include "ListWidget.hxx"
 #include "ScrollBarWidget.hxx"
@@ -71,7 +69,8 @@ EventHandler::EventHandler(OSystem* osystem)
     myState(S_NONE),
     myGrabMouseFlag(false),
     myAllowAllDirectionsFlag(false),
-    myFryingFlag(false)
+    myFryingFlag(false),
+    myJoyDeadZone(3200)
 {
   // Create the event object which will be used for this handler
   myEvent = new Event();
@@ -160,8 +159,7 @@ void EventHandler::initialize()
 
   myGrabMouseFlag = myOSystem->settings().getBool("grabmouse");
 
-  Joystick::setDeadZone(myOSystem->settings().getInt("joydeadzone"));
-  Paddles::setDigitalSpeed(myOSystem->settings().getInt("pspeed"));
+  setJoyDeadZone(myOSystem->settings().getInt("joydeadzone"));
 
   // Set quick select delay when typing characters in listwidgets
   ListWidget::setQuickSelectDelay(myOSystem->settings().getInt("listdelay"));
@@ -336,7 +334,7 @@ void EventHandler::handleWiiJoyAxisEvents( const int joyIndex, const int wiiJoyI
     s8 gcX = PAD_StickX( wiiJoyIndex );
     s8 gcY = PAD_StickY( wiiJoyIndex );
 
-    int deadzone = Joystick::deadzone();
+    int deadzone = myJoyDeadZone;
 
     if( held & ( WII_BUTTON_ATARI_UP | ( isClassic ? WII_CLASSIC_ATARI_UP : 0 ) ) || 
         gcHeld & GC_BUTTON_ATARI_UP || 
@@ -833,6 +831,13 @@ void EventHandler::poll(uInt32 time)
               case SDLK_l:
                 myOSystem->frameBuffer().toggleFrameStats();
                 break;
+
+              case SDLK_r:  // Alt-r starts/stops rewind mode
+                if(myOSystem->state().toggleRewindMode())
+                  myOSystem->frameBuffer().showMessage("Rewind mode started");
+                else
+                  myOSystem->frameBuffer().showMessage("Rewind mode stopped");
+                break;
 #if 0
 // FIXME - these will be removed when a UI is added for event recording
               case SDLK_e:  // Alt-e starts/stops event recording
@@ -842,11 +847,11 @@ void EventHandler::poll(uInt32 time)
                   myOSystem->frameBuffer().showMessage("Recording stopped");
                 break;
 
-              case SDLK_r:  // Alt-r starts/stops rewind mode
-                if(myOSystem->state().toggleRewindMode())
-                  myOSystem->frameBuffer().showMessage("Rewind mode started");
+              case SDLK_y:  // Alt-y starts/stops event playback
+                if(myOSystem->state().togglePlaybackMode())
+                  myOSystem->frameBuffer().showMessage("Playback started");
                 else
-                  myOSystem->frameBuffer().showMessage("Rewind mode stopped");
+                  myOSystem->frameBuffer().showMessage("Playback stopped");
                 break;
 /*
               case SDLK_l:  // Alt-l loads a recording
@@ -1305,7 +1310,7 @@ void EventHandler::handleJoyAxisEvent(int stick, int axis, int value)
     default:
     {
       // Otherwise, we know the event is digital
-      int deadzone = Joystick::deadzone();
+      int deadzone = myJoyDeadZone;
       if(value > -deadzone && value < deadzone)
       {
         // Turn off both events, since we don't know exactly which one
@@ -2290,12 +2295,23 @@ void EventHandler::takeSnapshot()
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void EventHandler::setJoyDeadZone(int deadzone)
+{
+  if(deadzone < 0)  deadzone = 0;
+  if(deadzone > 29) deadzone = 29;
+
+  myJoyDeadZone = 3200 + deadzone * 1000;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void EventHandler::setPaddleMode(int num, bool showmessage)
 {
   if(num >= 0 && num <= 3)
   {
-    Paddles::setMouseIsPaddle(num);
+    myOSystem->settings().setInt("mpaddle", num);
+    if(&myOSystem->console())
+      myOSystem->console().setPaddleMode(num);
     if(showmessage)
     {
       ostringstream buf;
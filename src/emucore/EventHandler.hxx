@@ -194,6 +194,14 @@ class EventHandler
     */
     void setPaddleMode(int num, bool showmessage = false);
 
+    /**
+      Sets the deadzone amount for real analog joysticks.
+
+      @param deadzone  The deadzone setting (0 - 29)
+    */
+    void setJoyDeadZone(int deadzone);
+    int joyDeadZone() const { return myJoyDeadZone; }
+
     inline bool kbdAlt(int mod)
     {
   #ifndef MAC_OSX
@@ -502,6 +510,9 @@ class EventHandler
     // Indicates whether or not we're in frying mode
     bool myFryingFlag;
 
+    // Deadzone for analog joystick axes
+    int myJoyDeadZone;
+
     // Indicates which paddle the mouse currently emulates
     Int8 myPaddleMode;
 
@@ -29,7 +29,11 @@
 #include "Launcher.hxx"
 #include "Menu.hxx"
 #include "OSystem.hxx"
+#include "PerfCounters.hxx"
+#include "RunAhead.hxx"
 #include "Settings.hxx"
+#include "Sound.hxx"
+#include "System.hxx"
 #include "TIA.hxx"
 
 #include "FrameBuffer.hxx"
@@ -52,6 +56,7 @@ FrameBuffer::FrameBuffer(OSystem* osystem)
     myPhosphorBlend(77),
     myInitializedCount(0),
     myPausedCount(0),
+    mySoundTime(0),
     mySurfaceCount(0)
 {
   myMsg.surface   = myStatsMsg.surface = NULL;
@@ -138,8 +143,8 @@ bool FrameBuffer::initialize(const string& title, uInt32 width, uInt32 height)
 
   // Create surfaces for TIA statistics and general messages
   myStatsMsg.color = kBtnTextColor;
-  myStatsMsg.w = myOSystem->consoleFont().getMaxCharWidth() * 21;
-  myStatsMsg.h = (myOSystem->consoleFont().getFontHeight() + 2) * 3;
+  myStatsMsg.w = myOSystem->consoleFont().getMaxCharWidth() * 24;
+  myStatsMsg.h = (myOSystem->consoleFont().getFontHeight() + 2) * 8;
 
  if(myStatsMsg.surface == NULL)
   {
@@ -165,6 +170,10 @@ extern double current_fps;
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FrameBuffer::update()
 {
+  // The counters of an emulated frame, and when its presenting started
+  PerfCounters* counters = NULL;
+  uInt32 presentStart = 0;
+
   // Determine which mode we are in (from the EventHandler)
   // Take care of S_EMULATE mode here, otherwise let the GUI
   // figure out what to draw
@@ -172,10 +181,27 @@ void FrameBuffer::update()
   {
     case EventHandler::S_EMULATE:
     {
+#ifdef WII
+      // If in debug mode, show stats
+      bool showStats = wii_debug;
+#else
+      bool showStats = myStatsMsg.enabled;
+#endif
+      // Only count and time the core when someone is looking at the results
+      PerfCounters& perf = myOSystem->console().system().counters();
+      bool measure = showStats || perf.isLogging();
+      perf.setCounting(measure);
+      perf.setTiming(measure);
+
       // Run the console for one frame
       // Note that the debugger can cause a breakpoint to occur, which changes
       // the EventHandler state 'behind our back' - we need to check for that
-      myOSystem->console().tia().update();
+      uInt32 start = PerfCounters::ticks();
+      if(&myOSystem->runAhead())
+        myOSystem->runAhead().update();
+      else
+        myOSystem->console().tia().update();
+      perf.addTime(PerfCounters::CPU, PerfCounters::ticks() - start);
   #ifdef DEBUGGER_SUPPORT
       if(myOSystem->eventHandler().state() != EventHandler::S_EMULATE) break;
   #endif
@@ -183,18 +209,15 @@ void FrameBuffer::update()
         myOSystem->console().fry();
 
       // And update the screen
+      counters = &perf;
+      presentStart = PerfCounters::ticks();
       drawTIA(myRedrawEntireFrame);
 
       // Show frame statistics
-#ifdef WII
-      // If in debug mode, show stats
-      if(wii_debug)
-#else
-      if(myStatsMsg.enabled)
-#endif
+      if(showStats)
       {
         const ConsoleInfo& info = myOSystem->console().about();
-        char msg[30];
+        char msg[48];
 #ifndef WII
         sprintf(msg, "%u LINES  %2.2f FPS",
                 myOSystem->console().tia().scanlines(),
@@ -211,6 +234,32 @@ void FrameBuffer::update()
           info.DisplayFormat, 1, 15, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
         myStatsMsg.surface->drawString(&myOSystem->consoleFont(),
           info.BankSwitch, 1, 30, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
+
+        // Counters for the previous frame
+        sprintf(msg, "INS %u  CYC %u", perf.frame(PerfCounters::Instructions),
+                perf.frame(PerfCounters::Cycles));
+        myStatsMsg.surface->drawString(&myOSystem->consoleFont(),
+          msg, 1, 45, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
+        sprintf(msg, "POKE %u  BANK %u", perf.frame(PerfCounters::TIAPokes),
+                perf.frame(PerfCounters::BankSwitches));
+        myStatsMsg.surface->drawString(&myOSystem->consoleFont(),
+          msg, 1, 60, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
+        uInt32 memsetPixels = perf.frame(PerfCounters::MemsetPixels);
+        sprintf(msg, "UPD %u  PIX %u/%u", perf.frame(PerfCounters::FrameUpdates),
+                perf.frame(PerfCounters::Pixels) - memsetPixels, memsetPixels);
+        myStatsMsg.surface->drawString(&myOSystem->consoleFont(),
+          msg, 1, 75, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
+        sprintf(msg, "PEEK %u/%u/%u", perf.framePeeks(PerfCounters::TIARegion),
+                perf.framePeeks(PerfCounters::RIOTRegion),
+                perf.framePeeks(PerfCounters::CartRegion));
+        myStatsMsg.surface->drawString(&myOSystem->consoleFont(),
+          msg, 1, 90, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
+        sprintf(msg, "US %u/%u/%u/%u", perf.frameTime(PerfCounters::CPU),
+                perf.frameTime(PerfCounters::TIA),
+                perf.frameTime(PerfCounters::Sound),
+                perf.frameTime(PerfCounters::Present));
+        myStatsMsg.surface->drawString(&myOSystem->consoleFont(),
+          msg, 1, 105, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
         myStatsMsg.surface->addDirtyRect(0, 0, 0, 0);  // force a full draw
         myStatsMsg.surface->setPos(myImageRect.x() + 3, myImageRect.y() + 3);
         myStatsMsg.surface->update();
@@ -279,6 +328,16 @@ void FrameBuffer::update()
   // Do any post-frame stuff
   postFrameUpdate();
 
+  // Finish the counters for an emulated frame
+  if(counters)
+  {
+    counters->addTime(PerfCounters::Present, PerfCounters::ticks() - presentStart);
+    uInt32 soundTime = myOSystem->sound().processingTime();
+    counters->addTime(PerfCounters::Sound, soundTime - mySoundTime);
+    mySoundTime = soundTime;
+    counters->endFrame(myOSystem->console().system());
+  }
+
   // The frame doesn't need to be completely redrawn anymore
 #ifdef WII
   // Force full redraw if we are double buffering
@@ -532,12 +591,21 @@ void FrameBuffer::resetSurfaces()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 FrameBuffer::tiaPixel(uInt32 idx) const
 {
-  uInt8 c = *(myOSystem->console().tia().currentFrameBuffer() + idx);
-  uInt8 p = *(myOSystem->console().tia().previousFrameBuffer() + idx);
+  uInt8 c = *(displayedTIA().currentFrameBuffer() + idx);
+  uInt8 p = *(displayedTIA().previousFrameBuffer() + idx);
 
   return (!myUsePhosphor ? myDefPalette[c] : myAvgPalette[c][p]);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const TIA& FrameBuffer::displayedTIA() const
+{
+  if(&myOSystem->runAhead())
+    return myOSystem->runAhead().tia();
+
+  return myOSystem->console().tia();
+}
+
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FrameBuffer::setTIAPalette(const uInt32* palette)
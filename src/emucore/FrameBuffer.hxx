@@ -25,6 +25,7 @@
 class FBSurface;
 class OSystem;
 class Console;
+class TIA;
 
 namespace GUI {
   class Font;
@@ -404,6 +405,12 @@ class FrameBuffer
     */
     void resetSurfaces();
 
+    /**
+      Answers the TIA holding the frame to show, which isn't the console's
+      own TIA when running ahead with a second console.
+    */
+    const TIA& displayedTIA() const;
+
   protected:
 #ifdef WII
     // Our logical palette (for 8bpp mode)
@@ -523,6 +530,9 @@ class FrameBuffer
     // Used to set intervals between messages while in pause mode
     uInt32 myPausedCount;
 
+    // The sound's processing time at the end of the last emulated frame
+    uInt32 mySoundTime;
+
     // Dimensions of the actual image, after zooming, and taking into account
     // any image 'centering'
     GUI::Rect myImageRect;
@@ -0,0 +1,90 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef FRONTEND_HXX
+#define FRONTEND_HXX
+
+class Debugger;
+class DetectionCache;
+class SerialPort;
+class Settings;
+
+#include "bspf.hxx"
+
+/**
+  This class is the part of the application (the OSystem) which the
+  emulation core uses.  The Console and Settings only see this interface,
+  so they can be built without the OSystem and, through it, without the
+  FrameBuffer, EventHandler and SDL.  When the core runs headless (see
+  libstella) there's no frontend at all.
+
+  @author  Stella team
+  @version $Id$
+*/
+class Frontend
+{
+  public:
+    /**
+      Destructor
+    */
+    virtual ~Frontend() { }
+
+  public:
+    /**
+      Adds the specified settings object to the frontend.
+
+      @param settings The settings object to add
+    */
+    virtual void attach(Settings* settings) = 0;
+
+    /**
+      Get the full path of the config file.
+    */
+    virtual const string& configFile() const = 0;
+
+    /**
+      Get the full/complete directory name for storing EEPROM files.
+    */
+    virtual const string& eepromDir() const = 0;
+
+    /**
+      Get the cache of autodetection results.
+    */
+    virtual DetectionCache& detectionCache() const = 0;
+
+    /**
+      Get the serial port (used by the AtariVox).
+    */
+    virtual SerialPort& serialPort() const = 0;
+
+#ifdef DEBUGGER_SUPPORT
+    /**
+      Get the ROM debugger.
+    */
+    virtual Debugger& debugger() const = 0;
+#endif
+
+    /**
+      Set the framerate the frontend runs the emulation at.
+
+      @param framerate  The video framerate to use
+    */
+    virtual void setFramerate(float framerate) = 0;
+};
+
+#endif
@@ -0,0 +1,164 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include "Console.hxx"
+#include "Props.hxx"
+#include "System.hxx"
+#include "TIA.hxx"
+
+#include "HashLog.hxx"
+
+#define HASH_HEADER "02070000hashes"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+HashLog::HashLog()
+  : myLogging(false),
+    myVerifying(false),
+    myStart(0),
+    myFrame(0),
+    myDiverged(false)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+HashLog::~HashLog()
+{
+  close();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 HashLog::hash(const Console& console)
+{
+  // 64-bit FNV-1a, over the state and then the framebuffer
+  uInt64 hash = 14695981039346656037ULL;
+  #define HASH_BYTES(data, length) \
+    for(uInt32 i = 0; i < (length); ++i) \
+      hash = (hash ^ (data)[i]) * 1099511628211ULL;
+
+  myState.reset();
+  console.system().save(myState);
+  HASH_BYTES(myState.data(), myState.size());
+
+  const TIA& tia = console.tia();
+  HASH_BYTES(tia.currentFrameBuffer(), tia.width() * tia.height());
+  #undef HASH_BYTES
+
+  return hash;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool HashLog::startLogging(const string& filename, const Console& console)
+{
+  close();
+
+  if(!myWriter.open(filename))
+    return false;
+
+  myWriter.putString(HASH_HEADER);
+  myWriter.putString(console.properties().get(Cartridge_MD5));
+  myLogging = true;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool HashLog::log(const Console& console)
+{
+  if(!myLogging)
+    return false;
+
+  uInt64 value = hash(console);
+  myWriter.putInt((int)(value & 0xffffffff));
+  myWriter.putInt((int)(value >> 32));
+
+  // Don't let the buffer grow during long sessions
+  if(++myFrame % kFlushInterval == 0)
+    return myWriter.flush();
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool HashLog::startVerifying(const string& filename, const Console& console)
+{
+  close();
+
+  if(!myReader.open(filename))
+    return false;
+
+  try
+  {
+    if(myReader.getString() != HASH_HEADER ||
+       myReader.getString() != console.properties().get(Cartridge_MD5))
+    {
+      myReader.close();
+      return false;
+    }
+  }
+  catch(...)
+  {
+    myReader.close();
+    return false;
+  }
+  myStart = myReader.position();
+  myVerifying = true;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool HashLog::verify(const Console& console)
+{
+  if(!myVerifying || myDiverged || myFrame >= frames())
+    return false;
+
+  uInt64 value = (uInt32) myReader.getInt();
+  value |= ((uInt64)(uInt32) myReader.getInt()) << 32;
+  if(hash(console) != value)
+  {
+    myDiverged = true;
+    return false;
+  }
+  ++myFrame;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool HashLog::close()
+{
+  bool result = true;
+  if(myLogging)
+  {
+    result = myWriter.flush();
+    myWriter.close();
+  }
+  if(myVerifying)
+    myReader.close();
+
+  myLogging = myVerifying = myDiverged = false;
+  myFrame = 0;
+
+  return result;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 HashLog::frames() const
+{
+  return myVerifying ? (myReader.size() - myStart) / 8 : myFrame;
+}
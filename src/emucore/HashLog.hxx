@@ -0,0 +1,156 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef HASH_LOG_HXX
+#define HASH_LOG_HXX
+
+class Console;
+
+#include "bspf.hxx"
+#include "Deserializer.hxx"
+#include "Serializer.hxx"
+
+/**
+  This class keeps a log of a 64-bit hash of the console for every frame,
+  or checks the console against such a log.  Logging the frames of a
+  movie and later verifying them while playing the movie back with a
+  changed core shows the first frame where the emulation differs.
+
+  The hash covers the state of the system (the RIOT RAM, the CPU and TIA
+  registers, and the cartridge) as well as the TIA framebuffer, but not
+  the controllers and switches, since those are the input recorded in
+  the movie.  It should be taken once per frame, right after the frame
+  has been emulated.
+
+  The log holds the ROM MD5 followed by eight bytes per frame.
+
+  @author  Stella team
+  @version $Id$
+*/
+class HashLog
+{
+  public:
+    /**
+      Create a new hash log, neither logging nor verifying.
+    */
+    HashLog();
+
+    /**
+      Destructor
+    */
+    virtual ~HashLog();
+
+  public:
+    /**
+      Calculate the hash of the current state of the console.
+    */
+    uInt64 hash(const Console& console);
+
+    /**
+      Start writing hashes of the given console to a log file.
+
+      @param filename  The file to write to
+      @param console   The console being logged
+      @return  False if the file couldn't be written, else true
+    */
+    bool startLogging(const string& filename, const Console& console);
+
+    /**
+      Add the hash of the console to the log.
+
+      @param console  The console being logged
+      @return  False on any errors, else true
+    */
+    bool log(const Console& console);
+
+    /**
+      Start checking the given console against a log file.
+
+      @param filename  The file to check against
+      @param console   The console being checked
+      @return  False if the file isn't a log for this ROM, else true
+    */
+    bool startVerifying(const string& filename, const Console& console);
+
+    /**
+      Check the hash of the console against the next one in the log.
+
+      @param console  The console being checked
+      @return  False if the hashes differ or at the end of the log
+    */
+    bool verify(const Console& console);
+
+    /**
+      Finish logging or verifying, closing the file.
+
+      @return  False if the file couldn't be written, else true
+    */
+    bool close();
+
+    /**
+      Answers whether hashes are being logged or verified.
+    */
+    bool isLogging() const   { return myLogging; }
+    bool isVerifying() const { return myVerifying; }
+
+    /**
+      Answers whether verify() has found a frame that differs.
+    */
+    bool diverged() const { return myDiverged; }
+
+    /**
+      Answers the number of frames logged or verified so far (when a
+      frame has diverged, this is that frame).
+    */
+    uInt32 frame() const { return myFrame; }
+
+    /**
+      Answers the number of frames in the log being verified.
+    */
+    uInt32 frames() const;
+
+  private:
+    enum {
+      kFlushInterval = 1024
+    };
+
+    // Copy constructor isn't supported by this class so make it private
+    HashLog(const HashLog&);
+
+    // Assignment operator isn't supported by this class so make it private
+    HashLog& operator = (const HashLog&);
+
+  private:
+    // The file being written or read
+    Serializer   myWriter;
+    Deserializer myReader;
+    bool myLogging;
+    bool myVerifying;
+
+    // Offset of the first hash in the file being read
+    uInt32 myStart;
+
+    // Number of frames logged or verified so far
+    uInt32 myFrame;
+    bool myDiverged;
+
+    // Scratch buffer holding the state being hashed
+    Serializer myState;
+};
+
+#endif
@@ -90,15 +90,3 @@ void Joystick::update()
   if(yaxis < -16384)
     myDigitalPinState[One] = false;
 }
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Joystick::setDeadZone(int deadzone)
-{
-  if(deadzone < 0)  deadzone = 0;
-  if(deadzone > 29) deadzone = 29;
-
-  _DEAD_ZONE = 3200 + deadzone * 1000;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int Joystick::_DEAD_ZONE = 3200;
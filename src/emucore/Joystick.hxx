@@ -53,22 +53,11 @@ class Joystick : public Controller
     */
     virtual void update();
 
-    /**
-      Sets the deadzone amount for real analog joysticks.
-      Technically, this isn't really used by the Joystick class at all,
-      but it seemed like the best place to put it.
-    */
-    static void setDeadZone(int deadzone);
-    inline static int deadzone() { return _DEAD_ZONE;  }
-
   private:
     // Pre-compute the events we care about based on given port
     // This will eliminate test for left or right port in update()
     Event::Type myUpEvent, myDownEvent, myLeftEvent, myRightEvent,
                 myXAxisValue, myYAxisValue, myFireEvent;
-
-
-    static int _DEAD_ZONE;
 };
 
 #endif
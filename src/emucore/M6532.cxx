@@ -20,7 +20,6 @@
 #include <iostream>
 
 #include "Console.hxx"
-#include "Random.hxx"
 #include "Switches.hxx"
 #include "System.hxx"
 #include "Serializer.hxx"
@@ -43,7 +42,7 @@ M6532::~M6532()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6532::reset()
 {
-  class Random random;
+  Random& random = myConsole.system().randGenerator();
 
   // Randomize the 128 bytes of memory
   for(uInt32 t = 0; t < 128; ++t)
@@ -103,8 +102,18 @@ void M6532::install(System& system, Device& device)
   {
     if((address & 0x1080) == 0x0080)
     {
-      access.directPeekBase = 0; 
-      access.directPokeBase = 0;
+      // RAM pages can be accessed directly, unless another device (such
+      // as the 4A50 cartridge) has taken over the address space
+      if(&device == this && (address & 0x0200) == 0x0000)
+      {
+        access.directPeekBase = &myRAM[address & 0x007f];
+        access.directPokeBase = &myRAM[address & 0x007f];
+      }
+      else
+      {
+        access.directPeekBase = 0; 
+        access.directPokeBase = 0;
+      }
       mySystem->setPageAccess(address >> shift, access);
     }
   }
@@ -113,10 +122,10 @@ void M6532::install(System& system, Device& device)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 M6532::peek(uInt16 addr)
 {
-  // Access RAM directly.  Originally, accesses to RAM could bypass
-  // this method and its pages could be installed directly into the
-  // system.  However, certain cartridges (notably 4A50) can mirror
-  // the RAM address space, making it necessary to chain accesses.
+  // Access RAM directly.  Normally the RAM pages are installed directly
+  // into the system and bypass this method.  However, certain cartridges
+  // (notably 4A50) can mirror the RAM address space, making it necessary
+  // to chain accesses.
   if((addr & 0x1080) == 0x0080 && (addr & 0x0200) == 0x0000)
   {
     return myRAM[addr & 0x007f];
@@ -212,10 +221,10 @@ uInt8 M6532::peek(uInt16 addr)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6532::poke(uInt16 addr, uInt8 value)
 {
-  // Access RAM directly.  Originally, accesses to RAM could bypass
-  // this method and its pages could be installed directly into the
-  // system.  However, certain cartridges (notably 4A50) can mirror
-  // the RAM address space, making it necessary to chain accesses.
+  // Access RAM directly.  Normally the RAM pages are installed directly
+  // into the system and bypass this method.  However, certain cartridges
+  // (notably 4A50) can mirror the RAM address space, making it necessary
+  // to chain accesses.
   if((addr & 0x1080) == 0x0080 && (addr & 0x0200) == 0x0000)
   {
     myRAM[addr & 0x007f] = value;
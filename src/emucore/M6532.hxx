@@ -126,6 +126,14 @@ class M6532 : public Device
     */
     virtual void poke(uInt16 address, uInt8 value);
 
+    /**
+      Get a pointer to the 128 bytes of RAM, for reading without the
+      side effects of going through the system (data bus state, traps)
+
+      @return  The RIOT RAM
+    */
+    const uInt8* getRAM() const { return myRAM; }
+
   private:
     inline Int32 timerClocks()
       { return myTimer - (mySystem->cycles() - myCyclesWhenTimerSet); }
@@ -0,0 +1,467 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include "Console.hxx"
+#include "Control.hxx"
+#include "Props.hxx"
+#include "Switches.hxx"
+#include "TIA.hxx"
+
+#include "Movie.hxx"
+
+#define MOVIE_HEADER "02070000movie"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Movie::Movie()
+  : myRecording(false),
+    myPlaying(false),
+    myInterval(kDefaultInterval),
+    myFrame(0),
+    myFrames(0),
+    myFlushed(0),
+    myRunLength(0),
+    myAnalogValid(false)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Movie::~Movie()
+{
+  if(myRecording)
+    stopRecording();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Movie::startRecording(const string& filename, const Console& console,
+                           uInt32 interval)
+{
+  if(myRecording)
+    stopRecording();
+  stopPlayback();
+
+  if(!myWriter.open(filename))
+    return false;
+
+  // The ROM and controllers must match for the movie to be played back,
+  // since some controllers behave differently with the same input
+  myWriter.putString(MOVIE_HEADER);
+  myWriter.putString(console.properties().get(Cartridge_MD5));
+  myWriter.putString(console.controller(Controller::Left).name());
+  myWriter.putString(console.controller(Controller::Right).name());
+  myInterval = interval > 0 ? interval : 1;
+  myWriter.putInt(myInterval);
+
+  myIndex.clear();
+  myFlushed   = 0;
+  myFrame     = 0;
+  myFrames    = 0;
+  myRunLength = 0;
+  myRecording = true;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Movie::record(const Console& console)
+{
+  if(!myRecording)
+    return false;
+
+  // Runs never cross into the next chunk
+  if(myFrame % myInterval == 0)
+  {
+    endRun();
+    if(!startChunk(console))
+      return false;
+  }
+
+  Input input;
+  getInput(console, input);
+  if(myRunLength > 0 && myRunLength < kMaxRunLength && input == myInput)
+    ++myRunLength;
+  else
+  {
+    endRun();
+    myInput = input;
+    myRunLength = 1;
+  }
+  ++myFrame;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Movie::stopRecording()
+{
+  if(!myRecording)
+    return false;
+
+  // End the last chunk, and then add the index; it starts with a zero
+  // where the state length of the next chunk would be
+  endRun();
+  if(!myIndex.isEmpty())
+    myWriter.putByte(0);
+
+  uInt32 indexOffset = myFlushed + myWriter.size();
+  myWriter.putInt(0);
+  myWriter.putInt(myFrame);
+  myWriter.putInt(myIndex.size());
+  for(unsigned int i = 0; i < myIndex.size(); ++i)
+    myWriter.putInt(myIndex[i]);
+  myWriter.putInt(indexOffset);
+
+  bool result = myWriter.flush();
+  myWriter.close();
+  myIndex.clear();
+  myRecording = false;
+
+  return result;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Movie::startPlayback(const string& filename, Console& console)
+{
+  if(myRecording)
+    stopRecording();
+  stopPlayback();
+
+  if(!myReader.open(filename))
+    return false;
+
+  try
+  {
+    if(myReader.getString() != MOVIE_HEADER ||
+       myReader.getString() != console.properties().get(Cartridge_MD5))
+      return false;
+
+    const string& left  = myReader.getString();
+    const string& right = myReader.getString();
+    if(left != console.controller(Controller::Left).name() ||
+       right != console.controller(Controller::Right).name())
+      return false;
+
+    myInterval = (uInt32) myReader.getInt();
+    if(myInterval == 0)
+      return false;
+    uInt32 start = myReader.position();
+
+    // The index is found through the offset at the very end of the file
+    bool indexed = false;
+    uInt32 size = myReader.size();
+    if(size >= start + 16)
+    {
+      myReader.seek(size - 4);
+      uInt32 indexOffset = (uInt32) myReader.getInt();
+      if(indexOffset >= start && indexOffset <= size - 16)
+      {
+        myReader.seek(indexOffset);
+        uInt32 marker = (uInt32) myReader.getInt();
+        uInt32 frames = (uInt32) myReader.getInt();
+        uInt32 chunks = (uInt32) myReader.getInt();
+        if(marker == 0 && chunks < size / 4 &&
+           size - indexOffset == 16 + chunks * 4 &&
+           (frames + myInterval - 1) / myInterval == chunks)
+        {
+          myIndex.clear();
+          for(uInt32 i = 0; i < chunks; ++i)
+            myIndex.push_back((uInt32) myReader.getInt());
+          myFrames = frames;
+          indexed = true;
+        }
+      }
+    }
+    if(!indexed)
+      rebuildIndex(start);
+  }
+  catch(...)
+  {
+    return false;
+  }
+
+  myPlaying = true;
+  if(myFrames == 0 || !seek(console, 0))
+  {
+    stopPlayback();
+    return false;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Movie::play(Console& console)
+{
+  if(!myPlaying || myFrame >= myFrames)
+    return false;
+
+  try
+  {
+    if(myRunLength == 0 && !readRun())
+    {
+      // The next chunk starts with a state, which isn't needed when
+      // playing straight through
+      uInt32 length = (uInt32) myReader.getInt();
+      myReader.seek(myReader.position() + length);
+      if(!readRun())
+        return false;
+    }
+  }
+  catch(...)
+  {
+    return false;
+  }
+  --myRunLength;
+  ++myFrame;
+
+  return setInput(console, myInput);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Movie::seek(Console& console, uInt32 frame)
+{
+  if(!myPlaying || frame >= myFrames)
+    return false;
+
+  // Restore the state at the start of the chunk holding the frame
+  uInt32 chunk = frame / myInterval;
+  myReader.seek(myIndex[chunk]);
+  try
+  {
+    uInt32 length = (uInt32) myReader.getInt();
+    uInt32 input = myReader.position() + length;
+    if(!console.load(myReader))
+      return false;
+    myReader.seek(input);
+  }
+  catch(...)
+  {
+    return false;
+  }
+  myFrame = chunk * myInterval;
+  myRunLength = 0;
+
+  // Then replay the input up to the frame, without rendering anything
+  TIA& tia = console.tia();
+  tia.setRenderSkip(true);
+  bool result = true;
+  while(result && myFrame < frame)
+  {
+    result = play(console);
+    if(result)
+      tia.update();
+  }
+  tia.setRenderSkip(false);
+
+  return result;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Movie::stopPlayback()
+{
+  myReader.close();
+
+  myIndex.clear();
+  myPlaying = false;
+  myFrame  = 0;
+  myFrames = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Movie::startChunk(const Console& console)
+{
+  // Send everything so far to the file, so the buffer doesn't keep
+  // growing during long recordings
+  if(!myIndex.isEmpty())
+    myWriter.putByte(0);
+  myFlushed += myWriter.size();
+  if(!myWriter.flush())
+    return false;
+
+  // The state is preceded by its length, so it can be skipped
+  myPinWriter.reset();
+  if(!console.save(myPinWriter))
+    return false;
+
+  myIndex.push_back(myFlushed);
+  myWriter.putInt(myPinWriter.size());
+  const uInt8* state = myPinWriter.data();
+  for(uInt32 i = 0; i < myPinWriter.size(); ++i)
+    myWriter.putByte((char)state[i]);
+  myAnalogValid = false;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Movie::endRun()
+{
+  if(myRunLength == 0)
+    return;
+
+  // A run is its length, one byte for each jack, and one for the
+  // switches; the analog pins of a jack follow if its kAnalogFlag is set
+  bool analog[2];
+  myWriter.putByte((char)myRunLength);
+  for(int i = 0; i < 2; ++i)
+  {
+    analog[i] = !myAnalogValid ||
+                myInput.analog[i][0] != myAnalog[i][0] ||
+                myInput.analog[i][1] != myAnalog[i][1];
+    myWriter.putByte((char)(myInput.pins[i] | (analog[i] ? kAnalogFlag : 0)));
+  }
+  myWriter.putByte((char)myInput.switches);
+  for(int i = 0; i < 2; ++i)
+  {
+    if(analog[i])
+    {
+      myWriter.putInt(myInput.analog[i][0]);
+      myWriter.putInt(myInput.analog[i][1]);
+      myAnalog[i][0] = myInput.analog[i][0];
+      myAnalog[i][1] = myInput.analog[i][1];
+    }
+  }
+  myAnalogValid = true;
+  myRunLength = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Movie::readRun()
+{
+  myRunLength = (uInt8) myReader.getByte();
+  if(myRunLength == 0)
+    return false;
+
+  uInt8 pins[2];
+  pins[0] = (uInt8) myReader.getByte();
+  pins[1] = (uInt8) myReader.getByte();
+  myInput.switches = (uInt8) myReader.getByte();
+  for(int i = 0; i < 2; ++i)
+  {
+    myInput.pins[i] = pins[i] & ~kAnalogFlag;
+    if(pins[i] & kAnalogFlag)
+    {
+      myInput.analog[i][0] = (Int32) myReader.getInt();
+      myInput.analog[i][1] = (Int32) myReader.getInt();
+    }
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Movie::rebuildIndex(uInt32 start)
+{
+  myIndex.clear();
+  myFrames = 0;
+
+  // Only keep complete chunks; a recording that was cut off may end
+  // anywhere
+  myReader.seek(start);
+  try
+  {
+    for(;;)
+    {
+      uInt32 offset = myReader.position();
+      uInt32 length = (uInt32) myReader.getInt();
+      if(length == 0 || length > myReader.size() - myReader.position())
+        break;
+      myReader.seek(myReader.position() + length);
+
+      uInt32 frames = 0;
+      while(readRun())
+        frames += myRunLength;
+
+      myIndex.push_back(offset);
+      myFrames += frames;
+      if(frames != myInterval)
+        break;
+    }
+  }
+  catch(...)
+  {
+  }
+  myRunLength = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Movie::getInput(const Console& console, Input& input)
+{
+  // The pins are read back through the controllers' own state, since
+  // reading them directly has side effects for some controllers
+  for(int i = 0; i < 2; ++i)
+  {
+    const Controller::Jack jack = i == 0 ? Controller::Left : Controller::Right;
+    myPinWriter.reset();
+    console.controller(jack).save(myPinWriter);
+    myPinReader.open(myPinWriter.data(), myPinWriter.size());
+
+    input.pins[i] = 0;
+    for(int bit = 0; bit < 5; ++bit)
+      if(myPinReader.getBool())
+        input.pins[i] |= 1 << bit;
+    input.analog[i][0] = (Int32) myPinReader.getInt();
+    input.analog[i][1] = (Int32) myPinReader.getInt();
+  }
+  input.switches = console.switches().read();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Movie::setInput(Console& console, const Input& input)
+{
+  for(int i = 0; i < 2; ++i)
+  {
+    const Controller::Jack jack = i == 0 ? Controller::Left : Controller::Right;
+    myPinWriter.reset();
+    for(int bit = 0; bit < 5; ++bit)
+      myPinWriter.putBool(input.pins[i] & (1 << bit));
+    myPinWriter.putInt(input.analog[i][0]);
+    myPinWriter.putInt(input.analog[i][1]);
+    myPinReader.open(myPinWriter.data(), myPinWriter.size());
+    if(!console.controller(jack).load(myPinReader))
+      return false;
+  }
+
+  myPinWriter.reset();
+  myPinWriter.putByte((char)input.switches);
+  myPinReader.open(myPinWriter.data(), myPinWriter.size());
+
+  return console.switches().load(myPinReader);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Movie::Input::operator == (const Input& other) const
+{
+  return pins[0] == other.pins[0] && pins[1] == other.pins[1] &&
+         switches == other.switches &&
+         analog[0][0] == other.analog[0][0] &&
+         analog[0][1] == other.analog[0][1] &&
+         analog[1][0] == other.analog[1][0] &&
+         analog[1][1] == other.analog[1][1];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Movie::Movie(const Movie&)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Movie& Movie::operator = (const Movie&)
+{
+  assert(false);
+  return *this;
+}
@@ -0,0 +1,232 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef MOVIE_HXX
+#define MOVIE_HXX
+
+class Console;
+
+#include "bspf.hxx"
+#include "Array.hxx"
+#include "Deserializer.hxx"
+#include "Serializer.hxx"
+
+/**
+  This class records the input of a console to a movie file, and plays it
+  back later.
+
+  The input for each frame (the digital pins of both controllers and the
+  console switches) is packed into a few bits, and identical frames are
+  stored as a single run; the analog pins are only stored when they've
+  changed.  Every 'interval' frames the file contains a complete state of
+  the console, which starts a new chunk of input.  An index of the chunks
+  is written at the end of the file, so playback can go to any frame by
+  restoring the state of its chunk and replaying less than 'interval'
+  frames, no matter how long the movie is.
+
+  If a recording wasn't stopped properly, the index is missing; it's then
+  rebuilt by walking through the chunks when the movie is opened.
+
+  @author  Stella team
+  @version $Id$
+*/
+class Movie
+{
+  public:
+    /**
+      Create a new movie object, neither recording nor playing.
+    */
+    Movie();
+
+    /**
+      Destructor
+    */
+    virtual ~Movie();
+
+  public:
+    /**
+      Start recording the given console to a movie file.
+
+      @param filename  The file to record to
+      @param console   The console to record
+      @param interval  The number of frames between complete states
+      @return  False if the file couldn't be written, else true
+    */
+    bool startRecording(const string& filename, const Console& console,
+                        uInt32 interval = kDefaultInterval);
+
+    /**
+      Record the input for the frame about to be emulated.  This should be
+      called once per frame, after the input for the frame has been set in
+      the controllers and switches, and before the frame is emulated.
+
+      @param console  The console being recorded
+      @return  False on any errors, else true
+    */
+    bool record(const Console& console);
+
+    /**
+      Finish the recording, writing the index and closing the file.
+
+      @return  False if the file couldn't be written, else true
+    */
+    bool stopRecording();
+
+    /**
+      Open a movie file for playback, and restore the console to the
+      state it was in when the recording started.  The ROM and the
+      controllers must be the same ones that were recorded.
+
+      @param filename  The file to play back
+      @param console   The console to play it on
+      @return  False if the movie can't be played on this console
+    */
+    bool startPlayback(const string& filename, Console& console);
+
+    /**
+      Apply the recorded input for the next frame to the console.  This
+      should be called once per frame, before the frame is emulated.
+
+      @param console  The console being played back
+      @return  False at the end of the movie or on any errors
+    */
+    bool play(Console& console);
+
+    /**
+      Restore the console to the start of the given frame; the input for
+      that frame is applied by the next call to play().
+
+      @param console  The console being played back
+      @param frame    The frame to go to, from 0 to frames() - 1
+      @return  False if the frame isn't in the movie or on any errors
+    */
+    bool seek(Console& console, uInt32 frame);
+
+    /**
+      Close the movie file being played back.
+    */
+    void stopPlayback();
+
+    /**
+      Answers whether a movie is being recorded.
+    */
+    bool isRecording() const { return myRecording; }
+
+    /**
+      Answers whether a movie is being played back.
+    */
+    bool isPlaying() const { return myPlaying; }
+
+    /**
+      Answers the frame that will be recorded or played next.
+    */
+    uInt32 frame() const { return myFrame; }
+
+    /**
+      Answers the number of frames in the movie being played back.
+    */
+    uInt32 frames() const { return myFrames; }
+
+  private:
+    // The input for a single frame
+    struct Input {
+      uInt8 pins[2];       // Digital pins One - Four and Six of each jack
+      Int32 analog[2][2];  // Analog pins Five and Nine of each jack
+      uInt8 switches;      // Console switches
+
+      bool operator == (const Input& other) const;
+    };
+
+    enum {
+      kDefaultInterval = 600,
+      kMaxRunLength    = 255,
+      kAnalogFlag      = 0x80
+    };
+
+    /**
+      Start a new chunk with a complete state of the console.
+    */
+    bool startChunk(const Console& console);
+
+    /**
+      Write the current run of identical frames to the file.
+    */
+    void endRun();
+
+    /**
+      Read the next run of identical frames.
+
+      @return  False at the end of a chunk, else true
+    */
+    bool readRun();
+
+    /**
+      Find the chunks (and the number of frames) by walking through a
+      movie file that has no index.
+
+      @param start  The offset of the first chunk
+    */
+    void rebuildIndex(uInt32 start);
+
+    /**
+      Get and set the controller and switch state of a console.
+    */
+    void getInput(const Console& console, Input& input);
+    bool setInput(Console& console, const Input& input);
+
+    // Copy constructor isn't supported by this class so make it private
+    Movie(const Movie&);
+
+    // Assignment operator isn't supported by this class so make it private
+    Movie& operator = (const Movie&);
+
+  private:
+    // The file being recorded or played back
+    Serializer   myWriter;
+    Deserializer myReader;
+    bool myRecording;
+    bool myPlaying;
+
+    // Number of frames between complete states
+    uInt32 myInterval;
+
+    // The frame that will be recorded or played next, and the total
+    uInt32 myFrame;
+    uInt32 myFrames;
+
+    // Offset of each chunk in the file
+    Common::Array<uInt32> myIndex;
+
+    // Bytes already sent to the file while recording
+    uInt32 myFlushed;
+
+    // The input of the current run, and how many frames are left in it
+    // (or have been recorded in it)
+    Input  myInput;
+    uInt32 myRunLength;
+
+    // The analog pins are stored when they differ from these
+    Int32 myAnalog[2][2];
+    bool  myAnalogValid;
+
+    // Scratch buffers used to get and set the controller pins
+    Serializer   myPinWriter;
+    Deserializer myPinReader;
+};
+
+#endif
@@ -56,6 +56,11 @@
 #include "MD5.hxx"
 #include "Settings.hxx"
 #include "PropsSet.hxx"
+#include "Props.hxx"
+#include "Cart.hxx"
+#include "RunAhead.hxx"
+#include "SoundNull.hxx"
+#include "DetectionCache.hxx"
 #include "EventHandler.hxx"
 #include "Menu.hxx"
 #include "CommandMenu.hxx"
@@ -67,7 +72,6 @@
 #include "ConsoleFont.hxx"
 #include "Widget.hxx"
 #include "Console.hxx"
-#include "Random.hxx"
 #include "StateManager.hxx"
 
 #include "OSystem.hxx"
@@ -94,7 +98,9 @@ OSystem::OSystem()
     mySound(NULL),
     mySettings(NULL),
     myPropSet(NULL),
+    myDetectionCache(NULL),
     myConsole(NULL),
+    myRunAhead(NULL),
     mySerialPort(NULL),
     myMenu(NULL),
     myCommandMenu(NULL),
@@ -188,6 +194,9 @@ OSystem::~OSystem()
 
   delete myStateManager;
   delete myPropSet;
+  if(myDetectionCache)
+    myDetectionCache->save(myDetectionCacheFile);
+  delete myDetectionCache;
   delete myEventHandler;
 
   delete mySerialPort;
@@ -251,6 +260,10 @@ bool OSystem::create()
   // Create a properties set for us to use and set it up
   myPropSet = new PropertiesSet(this);
 
+  // Remember what autodetection found for ROMs we've already seen
+  myDetectionCache = new DetectionCache();
+  myDetectionCache->load(myDetectionCacheFile);
+
 #ifdef CHEATCODE_SUPPORT
   myCheatManager = new CheatManager(this);
   myCheatManager->loadCheatDatabase();
@@ -288,9 +301,6 @@ bool OSystem::create()
   mySerialPort = new SerialPort();
 #endif
 
-  // Let the random class know about us; it needs access to getTicks()
-  Random::setSystem(this);
-
   return true;
 }
 
@@ -344,6 +354,12 @@ void OSystem::setConfigPaths()
   mySettings->setString("propsfile", s);
   node = FilesystemNode(s);
   myPropertiesFile = node.getPath();
+
+  s = mySettings->getString("detectfile");
+  if(s == "") s = myBaseDir + BSPF_PATH_SEPARATOR + "stella.det";
+  mySettings->setString("detectfile", s);
+  node = FilesystemNode(s);
+  myDetectionCacheFile = node.getPath();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -499,6 +515,10 @@ bool OSystem::createConsole(const string& romfile, const string& md5sum)
       return false;
     }
     if(!audiofirst)  myConsole->initializeAudio();
+    createRunAhead();
+    const string& perfcsv = mySettings->getString("perfcsv");
+    if(perfcsv != "" && !myConsole->system().counters().startLogging(perfcsv))
+      cerr << "ERROR: Couldn't write performance counters to " << perfcsv << endl;
   #ifdef DEBUGGER_SUPPORT
     myDebugger->setConsole(myConsole);
     myDebugger->initialize();
@@ -554,6 +574,7 @@ void OSystem::deleteConsole()
            << "  Frames per second:  " << framesPerSecond << endl
            << endl;
     }
+    delete myRunAhead;  myRunAhead = NULL;
     delete myConsole;  myConsole = NULL;
   }
 }
@@ -644,9 +665,13 @@ Console* OSystem::openConsole(const string& romfile, string& md5)
     CMDLINE_PROPS_UPDATE("pp", Display_Phosphor);
     CMDLINE_PROPS_UPDATE("ppblend", Display_PPBlend);
 
-    Cartridge* cart = Cartridge::create(image, size, props, *mySettings);
+    Cartridge* cart = Cartridge::create(image, size, props, *mySettings,
+                                        myDetectionCache);
     if(cart)
       console = new Console(this, cart, props);
+
+    // Write back anything new right away, in case we don't exit cleanly
+    myDetectionCache->save(myDetectionCacheFile);
   }
   else
     cerr << "ERROR: Couldn't open " << romfile << endl;
@@ -658,6 +683,47 @@ Console* OSystem::openConsole(const string& romfile, string& md5)
   return console;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::createRunAhead()
+{
+  int frames = mySettings->getInt("runahead");
+  if(frames <= 0)
+    return;
+
+  Console* second = (Console*) NULL;
+  Sound* secondSound = (Sound*) NULL;
+  if(mySettings->getString("runaheadmode") != "single")
+  {
+    // The second console needs its own cartridge, so the ROM is loaded
+    // again; it uses the format already detected for the first console
+    string md5 = myRomMD5;
+    uInt8* image = 0;
+    uInt32 size  = 0;
+    if((image = openROM(myRomFile, md5, size)) != 0)
+    {
+      Properties props(myConsole->properties());
+      string format = myConsole->about().DisplayFormat;
+      if(format.length() > 0 && format[format.length()-1] == '*')
+        format.erase(format.length()-1);
+      props.set(Display_Format, format);
+
+      Cartridge* cart = Cartridge::create(image, size, props, *mySettings,
+                                          myDetectionCache);
+      if(cart)
+      {
+        secondSound = new SoundNull(this);
+        second = new Console(cart, props, *mySettings, *secondSound,
+                             *myEventHandler->event());
+      }
+      delete[] image;
+    }
+    if(!second)
+      cerr << "ERROR: Couldn't create second console for run-ahead" << endl;
+  }
+
+  myRunAhead = new RunAhead(*myConsole, frames, second, secondSound);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8* OSystem::openROM(const string& file, string& md5, uInt32& size)
 {
@@ -28,6 +28,8 @@ class Launcher;
 class Menu;
 class Properties;
 class PropertiesSet;
+class RunAhead;
+class DetectionCache;
 class SerialPort;
 class Settings;
 class Sound;
@@ -41,6 +43,7 @@ namespace GUI {
 #include "Array.hxx"
 #include "EventHandler.hxx"
 #include "FrameBuffer.hxx"
+#include "Frontend.hxx"
 #include "bspf.hxx"
 
 struct Resolution {
@@ -53,12 +56,12 @@ typedef Common::Array<Resolution> ResolutionList;
 /**
   This class provides an interface for accessing operating system specific
   functions.  It also comprises an overall parent object, to which all the
-  other objects belong.
+  other objects belong.  It's the Frontend that the emulation core uses.
 
   @author  Stephen Anthony
   @version $Id: OSystem.hxx,v 1.79 2009-01-24 17:32:29 stephena Exp $
 */
-class OSystem
+class OSystem : public Frontend
 {
   friend class EventHandler;
   friend class VideoDialog;
@@ -122,6 +125,13 @@ class OSystem
     */
     inline PropertiesSet& propSet() const { return *myPropSet; }
 
+    /**
+      Get the cache of autodetection results for the system
+
+      @return The detection cache object
+    */
+    inline DetectionCache& detectionCache() const { return *myDetectionCache; }
+
     /**
       Get the console of the system.
 
@@ -129,6 +139,14 @@ class OSystem
     */
     inline Console& console() const { return *myConsole; }
 
+    /**
+      Get the run-ahead object for the current console.  This only
+      exists when run-ahead has been enabled.
+
+      @return The run-ahead object
+    */
+    inline RunAhead& runAhead() const { return *myRunAhead; }
+
     /**
       Get the serial port of the system.
 
@@ -299,6 +317,14 @@ class OSystem
     */
     const string& propertiesFile() const { return myPropertiesFile; }
 
+    /**
+      This method should be called to get the full path of the
+      autodetection cache file.
+
+      @return String representing the full path of the cache filename.
+    */
+    const string& detectionCacheFile() const { return myDetectionCacheFile; }
+
     /**
       This method should be called to get the full path of the currently
       loaded ROM.
@@ -451,9 +477,15 @@ class OSystem
     // Pointer to the PropertiesSet object
     PropertiesSet* myPropSet;
 
+    // Pointer to the cache of autodetected cart types and display formats
+    DetectionCache* myDetectionCache;
+
     // Pointer to the (currently defined) Console object
     Console* myConsole;
 
+    // Pointer to the run-ahead object for the console (if enabled)
+    RunAhead* myRunAhead;
+
     // Pointer to the serial port object
     SerialPort* mySerialPort;
 
@@ -501,6 +533,7 @@ class OSystem
     string myConfigFile;
     string myPaletteFile;
     string myPropertiesFile;
+    string myDetectionCacheFile;
 
     string myRomFile;
     string myRomMD5;
@@ -570,6 +603,13 @@ class OSystem
     */
     Console* openConsole(const string& romfile, string& md5);
 
+    /**
+      Creates the run-ahead object for the current console, if run-ahead
+      has been enabled.  Depending on the 'runaheadmode' setting, this
+      loads the ROM again to create a second console.
+    */
+    void createRunAhead();
+
     /**
       Open the given ROM and return an array containing its contents.
       Also, the properties database is updated with a valid ROM name
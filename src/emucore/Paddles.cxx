@@ -29,7 +29,10 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Paddles::Paddles(Jack jack, const Event& event, const System& system, bool swap)
-  : Controller(jack, event, system, Controller::Paddles)
+  : Controller(jack, event, system, Controller::Paddles),
+    myDigitalSpeed(6),
+    myMouseXPaddle(swap ? 1 : 0),
+    myMouseYPaddle(-1)
 {
 
 #ifdef WII
@@ -58,7 +61,6 @@ Paddles::Paddles(Jack jack, const Event& event, const System& system, bool swap)
       myP1FireEvent1 = Event::PaddleOneFire;
       myP1FireEvent2 = Event::JoystickZeroFire3;
 
-      if(_MOUSEX_PADDLE < 0)  _MOUSEX_PADDLE = 0;
     }
     else
     {
@@ -78,7 +80,6 @@ Paddles::Paddles(Jack jack, const Event& event, const System& system, bool swap)
       myP1FireEvent1 = Event::PaddleZeroFire;
       myP1FireEvent2 = Event::JoystickZeroFire1;
 
-      if(_MOUSEX_PADDLE < 0)  _MOUSEX_PADDLE = 1;
     }
   }
   else
@@ -101,7 +102,6 @@ Paddles::Paddles(Jack jack, const Event& event, const System& system, bool swap)
       myP1FireEvent1 = Event::PaddleThreeFire;
       myP1FireEvent2 = Event::JoystickOneFire3;
 
-      if(_MOUSEX_PADDLE < 0)  _MOUSEX_PADDLE = 0;
     }
     else
     {
@@ -121,7 +121,6 @@ Paddles::Paddles(Jack jack, const Event& event, const System& system, bool swap)
       myP1FireEvent1 = Event::PaddleTwoFire;
       myP1FireEvent2 = Event::JoystickOneFire1;
 
-      if(_MOUSEX_PADDLE < 0)  _MOUSEX_PADDLE = 1;
     }
   }
 
@@ -354,12 +353,12 @@ void Paddles::update()
   if(myKeyRepeat0)
   {
     myPaddleRepeat0++;
-    if(myPaddleRepeat0 > _PADDLE_SPEED)  myPaddleRepeat0 = 2;
+    if(myPaddleRepeat0 > myDigitalSpeed)  myPaddleRepeat0 = 2;
   }
   if(myKeyRepeat1)
   {
     myPaddleRepeat1++;
-    if(myPaddleRepeat1 > _PADDLE_SPEED)  myPaddleRepeat1 = 2;
+    if(myPaddleRepeat1 > myDigitalSpeed)  myPaddleRepeat1 = 2;
   }
 
   myKeyRepeat0 = 0;
@@ -391,23 +390,23 @@ void Paddles::update()
   }
 
   // Mouse events
-  if(myJack == Left && (_MOUSEX_PADDLE == 0 || _MOUSEX_PADDLE == 1))
+  if(myJack == Left && (myMouseXPaddle == 0 || myMouseXPaddle == 1))
   {
     // TODO - add infrastructure to map mouse direction to increase or decrease charge
-    myCharge[_MOUSEX_PADDLE] -= myEvent.get(Event::MouseAxisXValue);
-    if(myCharge[_MOUSEX_PADDLE] < TRIGMIN) myCharge[_MOUSEX_PADDLE] = TRIGMIN;
-    if(myCharge[_MOUSEX_PADDLE] > TRIGMAX) myCharge[_MOUSEX_PADDLE] = TRIGMAX;
+    myCharge[myMouseXPaddle] -= myEvent.get(Event::MouseAxisXValue);
+    if(myCharge[myMouseXPaddle] < TRIGMIN) myCharge[myMouseXPaddle] = TRIGMIN;
+    if(myCharge[myMouseXPaddle] > TRIGMAX) myCharge[myMouseXPaddle] = TRIGMAX;
     if(myEvent.get(Event::MouseButtonValue))
-      myDigitalPinState[ourButtonPin[_MOUSEX_PADDLE]] = false;
+      myDigitalPinState[ourButtonPin[myMouseXPaddle]] = false;
   }
-  else if(myJack == Right && (_MOUSEX_PADDLE == 2 || _MOUSEX_PADDLE == 3))
+  else if(myJack == Right && (myMouseXPaddle == 2 || myMouseXPaddle == 3))
   {
     // TODO - add infrastructure to map mouse direction to increase or decrease charge
-    myCharge[_MOUSEX_PADDLE-2] -= myEvent.get(Event::MouseAxisXValue);
-    if(myCharge[_MOUSEX_PADDLE-2] < TRIGMIN) myCharge[_MOUSEX_PADDLE-2] = TRIGMIN;
-    if(myCharge[_MOUSEX_PADDLE-2] > TRIGMAX) myCharge[_MOUSEX_PADDLE-2] = TRIGMAX;
+    myCharge[myMouseXPaddle-2] -= myEvent.get(Event::MouseAxisXValue);
+    if(myCharge[myMouseXPaddle-2] < TRIGMIN) myCharge[myMouseXPaddle-2] = TRIGMIN;
+    if(myCharge[myMouseXPaddle-2] > TRIGMAX) myCharge[myMouseXPaddle-2] = TRIGMAX;
     if(myEvent.get(Event::MouseButtonValue))
-      myDigitalPinState[ourButtonPin[_MOUSEX_PADDLE-2]] = false;
+      myDigitalPinState[ourButtonPin[myMouseXPaddle-2]] = false;
   }
 
   // Axis events (possibly use analog values)
@@ -516,15 +515,10 @@ void Paddles::setMouseIsPaddle(int number, int dir)
 {
   // TODO - make mouse Y axis be actually used in the code above
   if(dir == 0)
-    _MOUSEX_PADDLE = number;
+    myMouseXPaddle = number;
   else
-    _MOUSEY_PADDLE = number;
+    myMouseYPaddle = number;
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int Paddles::_PADDLE_SPEED = 6;
-int Paddles::_MOUSEX_PADDLE = -1;
-int Paddles::_MOUSEY_PADDLE = -1;
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const Controller::DigitalPin Paddles::ourButtonPin[2] = { Four, Three };
@@ -0,0 +1,192 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <cstdio>
+
+#if defined(WII)
+  #include <ogc/lwp_watchdog.h>
+#elif defined(BSPF_WIN32)
+  #include <windows.h>
+#else
+  #include <sys/time.h>
+#endif
+
+#include "M6502.hxx"
+#include "System.hxx"
+
+#include "PerfCounters.hxx"
+
+static const char* ourCounterNames[PerfCounters::numCounters] = {
+  "instructions", "cycles", "tia_pokes", "frame_updates", "pixels",
+  "memset_pixels", "bankswitches"
+};
+
+static const char* ourTimerNames[PerfCounters::numTimers] = {
+  "cpu_us", "tia_us", "sound_us", "present_us"
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PerfCounters::PerfCounters(uInt16 pages, uInt16 pageShift)
+  : myNumberOfPages(pages),
+    myPageShift(pageShift),
+    myInstructions(0),
+    myFrames(0),
+    myCounting(false),
+    myTiming(false)
+{
+  for(int i = 0; i < numCounters; ++i)
+    myTotal[i] = myLast[i] = myFrame[i] = 0;
+  for(int i = 0; i < numTimers; ++i)
+    myTotalTime[i] = myLastTime[i] = myFrameTime[i] = 0;
+
+  myTotalPeeks = new uInt32[myNumberOfPages];
+  myLastPeeks  = new uInt32[myNumberOfPages];
+  myFramePeeks = new uInt32[myNumberOfPages];
+  for(uInt16 page = 0; page < myNumberOfPages; ++page)
+    myTotalPeeks[page] = myLastPeeks[page] = myFramePeeks[page] = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PerfCounters::~PerfCounters()
+{
+  stopLogging();
+
+  delete[] myTotalPeeks;
+  delete[] myLastPeeks;
+  delete[] myFramePeeks;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 PerfCounters::ticks()
+{
+#if defined(WII)
+  return (uInt32) ticks_to_microsecs(gettime());
+#elif defined(BSPF_WIN32)
+  LARGE_INTEGER now, frequency;
+  QueryPerformanceCounter(&now);
+  QueryPerformanceFrequency(&frequency);
+  // Divide first, as the count times a million can overflow 64 bits
+  LONGLONG seconds = now.QuadPart / frequency.QuadPart;
+  LONGLONG rest    = now.QuadPart % frequency.QuadPart;
+  return (uInt32) (seconds * 1000000 + rest * 1000000 / frequency.QuadPart);
+#else
+  timeval now;
+  gettimeofday(&now, 0);
+  return (uInt32) (now.tv_sec * 1000000 + now.tv_usec);
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PerfCounters::endFrame(System& system)
+{
+  // The CPU keeps its own count of instructions (which starts over when
+  // it's reset), and the system's cycles since they were last reset
+  // haven't been added to the total yet
+  uInt32 instructions = system.m6502().totalInstructionCount();
+  myTotal[Instructions] += instructions >= myInstructions ?
+                           instructions - myInstructions : instructions;
+  myInstructions = instructions;
+
+  for(int i = 0; i < numCounters; ++i)
+  {
+    uInt32 total = myTotal[i] + (i == Cycles ? system.cycles() : 0);
+    myFrame[i] = total - myLast[i];
+    myLast[i] = total;
+  }
+
+  for(int i = 0; i < numTimers; ++i)
+  {
+    myFrameTime[i] = myTotalTime[i] - myLastTime[i];
+    myLastTime[i] = myTotalTime[i];
+  }
+
+  // The CPU is timed over the whole frame, which includes the TIA
+  if(myFrameTime[CPU] > myFrameTime[TIA])
+    myFrameTime[CPU] -= myFrameTime[TIA];
+  else
+    myFrameTime[CPU] = 0;
+
+  for(uInt16 page = 0; page < myNumberOfPages; ++page)
+  {
+    myFramePeeks[page] = myTotalPeeks[page] - myLastPeeks[page];
+    myLastPeeks[page] = myTotalPeeks[page];
+  }
+
+  ++myFrames;
+
+  if(myLog.is_open())
+  {
+    myLog << myFrames;
+    for(int i = 0; i < numCounters; ++i)
+      myLog << ',' << myFrame[i];
+    for(int i = 0; i < numTimers; ++i)
+      myLog << ',' << myFrameTime[i];
+    for(uInt16 page = 0; page < myNumberOfPages; ++page)
+      myLog << ',' << myFramePeeks[page];
+    myLog << '\n';
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 PerfCounters::framePeeks(Region region) const
+{
+  uInt32 peeks = 0;
+  for(uInt16 page = 0; page < myNumberOfPages; ++page)
+  {
+    uInt16 address = page << myPageShift;
+    Region r = (address & 0x1000) ? CartRegion :
+               (address & 0x0080) ? RIOTRegion : TIARegion;
+    if(r == region)
+      peeks += myFramePeeks[page];
+  }
+  return peeks;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PerfCounters::startLogging(const string& filename)
+{
+  stopLogging();
+
+  myLog.open(filename.c_str(), ios::out | ios::trunc);
+  if(!myLog.is_open())
+    return false;
+
+  // One column per counter and timer, then one per page for the peeks,
+  // named by the address the page starts at
+  myLog << "frame";
+  for(int i = 0; i < numCounters; ++i)
+    myLog << ',' << ourCounterNames[i];
+  for(int i = 0; i < numTimers; ++i)
+    myLog << ',' << ourTimerNames[i];
+  for(uInt16 page = 0; page < myNumberOfPages; ++page)
+  {
+    char name[16];
+    sprintf(name, ",peeks_%04x", page << myPageShift);
+    myLog << name;
+  }
+  myLog << '\n';
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PerfCounters::stopLogging()
+{
+  if(myLog.is_open())
+    myLog.close();
+}
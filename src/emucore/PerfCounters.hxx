@@ -0,0 +1,240 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef PERF_COUNTERS_HXX
+#define PERF_COUNTERS_HXX
+
+class System;
+
+#include <fstream>
+#include "bspf.hxx"
+
+/**
+  This class holds cheap counters of the work done by the emulation core,
+  so a ROM which runs slowly can be blamed on a particular subsystem.
+  The core only ever adds to the running totals; once per frame those
+  are turned into the values for the frame which just finished, which
+  can be read from here, are shown in the stats overlay, and can also be
+  streamed to a CSV file (one line per frame).
+
+  The counters of the hot paths (everything but the cycles) are only
+  kept while counting is enabled, so when nobody looks at them the core
+  pays for one well-predicted test rather than a store.
+
+  Host time is measured for the CPU, the TIA, the sound and presenting
+  the frame.  Timing the TIA means reading the clock on every call of
+  TIA::updateFrame(), so that's only done while timing is enabled.
+
+  @author  Stella team
+  @version $Id$
+*/
+class PerfCounters
+{
+  public:
+    enum Counter {
+      Instructions,   // instructions executed by the CPU
+      Cycles,         // CPU cycles
+      TIAPokes,       // writes to the TIA
+      FrameUpdates,   // calls of TIA::updateFrame()
+      Pixels,         // pixels drawn into the framebuffer
+      MemsetPixels,   // pixels of those filled with memset()
+      BankSwitches,   // bankswitches made by the cartridge
+      numCounters
+    };
+
+    enum Timer {
+      CPU,            // emulating the frame, less the time in the TIA
+      TIA,            // updating the TIA framebuffer
+      Sound,          // generating sound samples
+      Present,        // drawing the frame on the screen
+      numTimers
+    };
+
+    enum Region {
+      TIARegion,      // pages with address bit 12 and 7 clear
+      RIOTRegion,     // pages with address bit 12 clear and 7 set
+      CartRegion      // pages with address bit 12 set
+    };
+
+    /**
+      Create counters for a system with the given number of pages.
+
+      @param pages      The number of pages in the system
+      @param pageShift  The amount to shift an address by to get its page
+    */
+    PerfCounters(uInt16 pages, uInt16 pageShift);
+
+    /**
+      Destructor
+    */
+    virtual ~PerfCounters();
+
+  public:
+    /**
+      Add to one of the counters, if counting is enabled.  These are
+      called from the hot paths of the core, so they're kept to a test
+      and a single add.
+    */
+    void count(Counter counter)
+      { if(myCounting) ++myTotal[counter]; }
+    void count(Counter counter, uInt32 amount)
+      { if(myCounting) myTotal[counter] += amount; }
+
+    /**
+      Count a peek which was handled by the device on the given page
+      (rather than read directly from memory), if counting is enabled.
+    */
+    void devicePeek(uInt16 page)
+      { if(myCounting) ++myTotalPeeks[page]; }
+
+    /**
+      Add to the cycles, which is done whether or not counting is enabled
+      (the system's cycles are only folded in when they're reset).
+    */
+    void addCycles(uInt32 cycles) { myTotal[Cycles] += cycles; }
+
+    /**
+      Add the given number of microseconds to one of the timers.
+    */
+    void addTime(Timer timer, uInt32 micros) { myTotalTime[timer] += micros; }
+
+    /**
+      Answers whether the counters of the hot paths are being kept.
+    */
+    bool counting() const { return myCounting; }
+
+    /**
+      Enable or disable the counters of the hot paths.
+    */
+    void setCounting(bool enable) { myCounting = enable; }
+
+    /**
+      Answers whether the more costly timing (of the TIA) is enabled.
+    */
+    bool timing() const { return myTiming; }
+
+    /**
+      Enable or disable the more costly timing.
+    */
+    void setTiming(bool enable) { myTiming = enable; }
+
+    /**
+      Get a host time in microseconds, used for the timers.
+    */
+    static uInt32 ticks();
+
+  public:
+    /**
+      Finish the current frame; the values since the last call become
+      the values for the frame, and are written to the CSV file (if any).
+
+      @param system  The system being counted
+    */
+    void endFrame(System& system);
+
+    /**
+      Get the value of a counter for the last frame.
+    */
+    uInt32 frame(Counter counter) const { return myFrame[counter]; }
+
+    /**
+      Get the microseconds spent in a timer in the last frame.
+    */
+    uInt32 frameTime(Timer timer) const { return myFrameTime[timer]; }
+
+    /**
+      Get the number of device peeks of the given page in the last frame.
+    */
+    uInt32 framePeeks(uInt16 page) const { return myFramePeeks[page]; }
+
+    /**
+      Get the number of device peeks of a region of the 2600's address
+      space in the last frame.
+    */
+    uInt32 framePeeks(Region region) const;
+
+    /**
+      Get the running total of a counter.
+    */
+    uInt32 total(Counter counter) const { return myTotal[counter]; }
+
+    /**
+      Get the number of frames which have been finished.
+    */
+    uInt32 frames() const { return myFrames; }
+
+    /**
+      Start writing the values of every frame to a CSV file.
+
+      @param filename  The file to write to
+      @return  False if the file couldn't be written, else true
+    */
+    bool startLogging(const string& filename);
+
+    /**
+      Stop writing the CSV file (if any).
+    */
+    void stopLogging();
+
+    /**
+      Answers whether the values are being written to a CSV file.
+    */
+    bool isLogging() const { return myLog.is_open(); }
+
+  private:
+    // Copy constructor isn't supported by this class so make it private
+    PerfCounters(const PerfCounters&);
+
+    // Assignment operator isn't supported by this class so make it private
+    PerfCounters& operator = (const PerfCounters&);
+
+  private:
+    // The number of pages in the system, and the page shift
+    uInt16 myNumberOfPages;
+    uInt16 myPageShift;
+
+    // The running totals, and their values at the end of the last frame
+    uInt32 myTotal[numCounters];
+    uInt32 myLast[numCounters];
+    uInt32 myFrame[numCounters];
+
+    uInt32 myTotalTime[numTimers];
+    uInt32 myLastTime[numTimers];
+    uInt32 myFrameTime[numTimers];
+
+    uInt32* myTotalPeeks;
+    uInt32* myLastPeeks;
+    uInt32* myFramePeeks;
+
+    // The CPU's own count of instructions at the end of the last frame
+    uInt32 myInstructions;
+
+    // The number of frames which have been finished
+    uInt32 myFrames;
+
+    // Whether the hot paths are being counted
+    bool myCounting;
+
+    // Whether the TIA is being timed
+    bool myTiming;
+
+    // The CSV file being written
+    ofstream myLog;
+};
+
+#endif
@@ -17,16 +17,18 @@
 //============================================================================
 
 #include <time.h>
-#include "OSystem.hxx"
 #include "Random.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Random::Random()
 {
-  if(ourSystem)
-    myValue = ourSystem->getTicks();
-  else
-    myValue = (uInt32)time(0);
+  initSeed((uInt32)time(0));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Random::initSeed(uInt32 seed)
+{
+  myValue = seed;
 }
  
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -34,6 +36,3 @@ uInt32 Random::next()
 {
   return (myValue = (myValue * 2416 + 374441) % 1771875);
 }
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const OSystem* Random::ourSystem = NULL;
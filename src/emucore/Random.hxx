@@ -19,8 +19,6 @@
 #ifndef RANDOM_HXX
 #define RANDOM_HXX
 
-class OSystem;
-
 #include "bspf.hxx"
 
 /**
@@ -28,6 +26,9 @@ class OSystem;
   information in Chapter 7 of "Numerical Recipes in C".  It's a simple 
   linear congruential generator.
 
+  Each System owns its own generator, so that independent consoles
+  never share (or race on) random number state.
+
   @author  Bradford W. Mott
   @version $Id: Random.hxx,v 1.7 2009-01-01 18:13:36 stephena Exp $
 */
@@ -35,34 +36,28 @@ class Random
 {
   public:
     /**
-      Create a new random number generator
+      Create a new random number generator, seeded from the current time
     */
     Random();
-    
-  public:
+
     /**
-      Answer the next random number from the random number generator
+      Reseed the random number generator
 
-      @return A random number
+      @param seed  The new seed value
     */
-    uInt32 next();
+    void initSeed(uInt32 seed);
 
+  public:
     /**
-      Class method which sets the OSystem in use; the constructor will
-      use this to reseed the random number generator every time a new
-      instance is created
+      Answer the next random number from the random number generator
 
-      @param system  The system currently in use
+      @return A random number
     */
-    static void setSystem(const OSystem* system) { ourSystem = system; }
+    uInt32 next();
 
   private:
     // Indicates the next random number
     uInt32 myValue;
-
-  private:
-    // Set the OSystem we're using
-    static const OSystem* ourSystem;
 };
 
 #endif
@@ -0,0 +1,482 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <cstring>
+
+#include "Console.hxx"
+#include "Control.hxx"
+#include "Deserializer.hxx"
+#include "Switches.hxx"
+#include "TIA.hxx"
+
+#include "RewindBuffer.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RewindBuffer::RewindBuffer()
+  : myArena(0),
+    myBudget(0),
+    myHead(0),
+    myHasPending(false),
+    myInterval(1),
+    myFrame(0)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RewindBuffer::~RewindBuffer()
+{
+  delete[] myArena;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindBuffer::setup(uInt32 budget, uInt32 interval)
+{
+  if(budget != myBudget)
+  {
+    delete[] myArena;
+    myArena  = budget > 0 ? new uInt8[budget] : 0;
+    myBudget = budget;
+  }
+  myInterval = interval > 0 ? interval : 1;
+
+  clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindBuffer::clear()
+{
+  mySegments.clear();
+  myHead = 0;
+  myHasPending = false;
+  myFrame = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RewindBuffer::record(const Console& console)
+{
+  if(!myArena)
+    return false;
+
+  // Capture a new state every 'interval' frames
+  if(!myHasPending || myFrame - myPending.frame >= myInterval)
+  {
+    if(myHasPending)
+      commitPending();
+
+    myCapture.reset();
+    if(!console.save(myCapture))
+      return false;
+
+    // A delta is always relative to the most recent keyframe, which is
+    // still in the arena if any segment is
+    uInt32 distance = 0;
+    if(!mySegments.isEmpty())
+    {
+      distance = mySegments[mySegments.size() - 1].keyDistance + 1;
+      if(distance >= kKeyframeInterval)
+        distance = 0;
+    }
+
+    myPendingData.resize(0);
+    if(distance == 0)
+    {
+      encode(myPendingData, myCapture.data(), myCapture.size(), 0, 0);
+      myKeyState.resize(0);
+      myKeyState.append(myCapture.data(), myCapture.size());
+    }
+    else
+      encode(myPendingData, myCapture.data(), myCapture.size(),
+             myKeyState.data, myKeyState.size);
+
+    myPending.offset      = 0;
+    myPending.stateLength = myPendingData.size;
+    myPending.rawLength   = myCapture.size();
+    myPending.frame       = myFrame;
+    myPending.frames      = 0;
+    myPending.inputLength = 0;
+    myPending.keyDistance = distance;
+    myHasPending = true;
+  }
+
+  // Log the input for this frame
+  saveInput(console);
+  myPending.frames++;
+  myFrame++;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RewindBuffer::seek(Console& console, uInt32 frame)
+{
+  // Find the segment that frame is in (segments share their end frame
+  // with the start of the next one, so prefer the later one)
+  int index = mySegments.size();
+  if(!(myHasPending && frame >= myPending.frame && frame <= myFrame))
+  {
+    for(index = mySegments.size() - 1; index >= 0; --index)
+      if(frame >= mySegments[index].frame &&
+         frame <= mySegments[index].frame + mySegments[index].frames)
+        break;
+    if(index < 0)
+      return false;
+  }
+  if(index == (int)mySegments.size())
+    index = -1;
+  const Segment& seg = segment(index);
+
+  // Restore the captured state
+  decodeState(index);
+  Deserializer state;
+  state.open(myState.data, myState.size);
+  if(!console.load(state))
+    return false;
+
+  // Then replay the recorded input up to the frame, without rendering
+  // anything but the frame itself
+  const uInt8* input = segmentData(index) + seg.stateLength;
+  TIA& tia = console.tia();
+  for(uInt32 i = seg.frame; i < frame; ++i)
+  {
+    input = loadInput(console, input);
+    tia.setRenderSkip(true);
+    tia.update();
+  }
+  tia.setRenderSkip(false);
+
+  if(frame < seg.frame + seg.frames)
+    loadInput(console, input);
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RewindBuffer::truncate(uInt32 frame)
+{
+  if(frame == myFrame)
+    return true;
+
+  if(!(myHasPending && frame >= myPending.frame && frame <= myFrame))
+  {
+    int index;
+    for(index = mySegments.size() - 1; index >= 0; --index)
+      if(frame >= mySegments[index].frame &&
+         frame <= mySegments[index].frame + mySegments[index].frames)
+        break;
+    if(index < 0)
+      return false;
+
+    reopenSegment(index);
+  }
+
+  // Input records vary in length, so find where the frame's one starts
+  const uInt8* input = myPendingData.data + myPending.stateLength;
+  const uInt8* end = input;
+  myPending.frames = frame - myPending.frame;
+  for(uInt32 i = 0; i < myPending.frames; ++i)
+    end = skipInput(end);
+  myPending.inputLength = end - input;
+  myPendingData.resize(myPending.length());
+  myFrame = frame;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 RewindBuffer::firstFrame() const
+{
+  if(!mySegments.isEmpty())
+    return mySegments[0].frame;
+
+  return myHasPending ? myPending.frame : myFrame;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 RewindBuffer::memoryUsed() const
+{
+  uInt32 used = 0;
+  for(unsigned int i = 0; i < mySegments.size(); ++i)
+    used += mySegments[i].length();
+
+  return used;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindBuffer::commitPending()
+{
+  myHasPending = false;
+
+  uInt32 length = myPending.length();
+  if(length > myBudget)
+  {
+    // This can't be stored at all, so there's no history left
+    mySegments.clear();
+    myHead = 0;
+    return;
+  }
+  if(myHead + length > myBudget)
+    myHead = 0;
+
+  // Discard history (oldest first) until nothing overlaps the new segment
+  int last = -1;
+  for(unsigned int i = 0; i < mySegments.size(); ++i)
+  {
+    const Segment& seg = mySegments[i];
+    if(seg.offset < myHead + length && seg.offset + seg.length() > myHead)
+      last = i;
+  }
+  for(int i = 0; i <= last; ++i)
+    mySegments.remove_at(0);
+
+  // Deltas are useless without the keyframe before them
+  while(!mySegments.isEmpty() && mySegments[0].keyDistance != 0)
+    mySegments.remove_at(0);
+  if(mySegments.isEmpty() && myPending.keyDistance != 0)
+    return;
+
+  memcpy(myArena + myHead, myPendingData.data, length);
+  myPending.offset = myHead;
+  mySegments.push_back(myPending);
+  myHead += length;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindBuffer::reopenSegment(int index)
+{
+  const Segment seg = mySegments[index];
+
+  // Deltas for the rest of this segment's group are made from its keyframe
+  decodeState(index - seg.keyDistance);
+  myKeyState.resize(0);
+  myKeyState.append(myState.data, myState.size);
+
+  myPendingData.resize(0);
+  myPendingData.append(myArena + seg.offset, seg.length());
+  myPending = seg;
+  myHasPending = true;
+  myHead = seg.offset;
+
+  while((int)mySegments.size() > index)
+    mySegments.remove_at(index);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindBuffer::decodeState(int index)
+{
+  const Segment& seg = segment(index);
+  if(seg.keyDistance == 0)
+  {
+    myState.resize(seg.rawLength);
+    memset(myState.data, 0, seg.rawLength);
+  }
+  else
+  {
+    // Start from the keyframe, padded with zeros if it's shorter
+    int key = (index < 0 ? (int)mySegments.size() : index) - seg.keyDistance;
+    decodeState(key);
+    uInt32 keyLength = myState.size;
+    myState.resize(seg.rawLength);
+    if(keyLength < seg.rawLength)
+      memset(myState.data + keyLength, 0, seg.rawLength - keyLength);
+  }
+  decode(myState.data, seg.rawLength, segmentData(index));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindBuffer::saveInput(const Console& console)
+{
+  uInt32 start = myPendingData.size;
+
+  // The switches, then the digital pins of each controller as one byte
+  myPendingData.append(console.switches().mySwitches);
+  uInt8 analog = 0;
+  for(int jack = 0; jack < 2; ++jack)
+  {
+    const Controller& controller = console.controller((Controller::Jack)jack);
+    uInt8 pins = 0;
+    for(int pin = 0; pin < 5; ++pin)
+      if(controller.myDigitalPinState[pin])
+        pins |= 1 << pin;
+    myPendingData.append(pins);
+
+    for(int pin = 0; pin < 2; ++pin)
+    {
+      Int32 value = controller.myAnalogPinValue[pin];
+      uInt8 code = value == Controller::maximumResistance ? kAnalogMaximum :
+                   value == Controller::minimumResistance ? kAnalogMinimum :
+                   kAnalogValue;
+      analog |= code << ((jack << 2) + (pin << 1));
+    }
+  }
+  myPendingData.append(analog);
+
+  // Followed by the analog values which aren't at either extreme
+  for(int jack = 0; jack < 2; ++jack)
+  {
+    const Controller& controller = console.controller((Controller::Jack)jack);
+    for(int pin = 0; pin < 2; ++pin)
+    {
+      if(((analog >> ((jack << 2) + (pin << 1))) & 0x03) != kAnalogValue)
+        continue;
+
+      uInt32 value = (uInt32) controller.myAnalogPinValue[pin];
+      myPendingData.append((uInt8) value);
+      myPendingData.append((uInt8)(value >> 8));
+      myPendingData.append((uInt8)(value >> 16));
+      myPendingData.append((uInt8)(value >> 24));
+    }
+  }
+
+  myPending.inputLength += myPendingData.size - start;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt8* RewindBuffer::loadInput(Console& console, const uInt8* in)
+{
+  console.switches().mySwitches = in[0];
+  uInt8 analog = in[3];
+  const uInt8* value = in + 4;
+  for(int jack = 0; jack < 2; ++jack)
+  {
+    Controller& controller = console.controller((Controller::Jack)jack);
+    for(int pin = 0; pin < 5; ++pin)
+      controller.myDigitalPinState[pin] = (in[1 + jack] >> pin) & 0x01;
+
+    for(int pin = 0; pin < 2; ++pin)
+    {
+      switch((analog >> ((jack << 2) + (pin << 1))) & 0x03)
+      {
+        case kAnalogMaximum:
+          controller.myAnalogPinValue[pin] = Controller::maximumResistance;
+          break;
+        case kAnalogMinimum:
+          controller.myAnalogPinValue[pin] = Controller::minimumResistance;
+          break;
+        default:
+          controller.myAnalogPinValue[pin] = (Int32)(value[0] |
+              (value[1] << 8) | (value[2] << 16) | ((uInt32)value[3] << 24));
+          value += 4;
+          break;
+      }
+    }
+  }
+
+  return value;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt8* RewindBuffer::skipInput(const uInt8* in)
+{
+  uInt32 length = 4;
+  for(int code = 0; code < 8; code += 2)
+    if(((in[3] >> code) & 0x03) == kAnalogValue)
+      length += 4;
+
+  return in + length;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt8* RewindBuffer::segmentData(int index) const
+{
+  return index < 0 ? myPendingData.data : myArena + mySegments[index].offset;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const RewindBuffer::Segment& RewindBuffer::segment(int index) const
+{
+  return index < 0 ? myPending : mySegments[index];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindBuffer::encode(Buffer& out, const uInt8* data, uInt32 length,
+                          const uInt8* base, uInt32 baseLength)
+{
+  // Each run starts with a control byte; 0x00 - 0x7f are followed by
+  // 1 - 128 literal bytes, and 0x80 - 0xff stand for 1 - 128 zero bytes
+  #define XOR_AT(i) (data[i] ^ ((i) < baseLength ? base[i] : 0))
+  uInt32 i = 0;
+  while(i < length)
+  {
+    uInt32 run = 0;
+    if(XOR_AT(i) == 0)
+    {
+      while(i + run < length && run < 128 && XOR_AT(i + run) == 0)
+        ++run;
+      out.append((uInt8)(0x80 + run - 1));
+    }
+    else
+    {
+      // Single zeros are cheaper to keep within a literal run
+      while(i + run < length && run < 128 &&
+            (XOR_AT(i + run) != 0 ||
+             (i + run + 1 < length && XOR_AT(i + run + 1) != 0)))
+        ++run;
+      out.append((uInt8)(run - 1));
+      for(uInt32 j = i; j < i + run; ++j)
+        out.append((uInt8)XOR_AT(j));
+    }
+    i += run;
+  }
+  #undef XOR_AT
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindBuffer::decode(uInt8* data, uInt32 length, const uInt8* in)
+{
+  uInt32 i = 0;
+  while(i < length)
+  {
+    uInt8 control = *in++;
+    uInt32 run = (control & 0x7f) + 1;
+    if(i + run > length)
+      run = length - i;
+
+    if(control & 0x80)
+      i += run;
+    else
+      while(run--)
+        data[i++] ^= *in++;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindBuffer::Buffer::reserve(uInt32 length)
+{
+  if(length <= capacity)
+    return;
+
+  uInt32 newCapacity = capacity > 0 ? capacity : 256;
+  while(newCapacity < length)
+    newCapacity <<= 1;
+
+  uInt8* newData = new uInt8[newCapacity];
+  if(size > 0)
+    memcpy(newData, data, size);
+  delete[] data;
+
+  data = newData;
+  capacity = newCapacity;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindBuffer::Buffer::append(const uInt8* bytes, uInt32 length)
+{
+  reserve(size + length);
+  memcpy(data + size, bytes, length);
+  size += length;
+}
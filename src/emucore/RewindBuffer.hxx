@@ -0,0 +1,260 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef REWIND_BUFFER_HXX
+#define REWIND_BUFFER_HXX
+
+class Console;
+
+#include "bspf.hxx"
+#include "Array.hxx"
+#include "Serializer.hxx"
+
+/**
+  This class keeps a history of the recent emulation state, so that the
+  console can be moved back to any frame within that history.
+
+  Every 'interval' frames a complete state of the console is captured,
+  and the controller and switch input for every frame is logged.  Going
+  back to a frame means restoring the nearest capture before it, and then
+  replaying the logged input for the frames in between.
+
+  The input log only holds what replaying needs: the console switches,
+  the digital pins of both controllers packed into a byte each, and a
+  byte saying whether each analog pin is at its minimum or maximum
+  resistance.  Any other analog value (paddles) follows as 4 bytes.
+
+  To keep the memory use down, only every kKeyframeInterval'th capture is
+  stored as a keyframe; all the others are stored as the XOR against the
+  previous keyframe.  Since most of a state doesn't change from one
+  capture to the next, that's mostly zeros, and every capture (keyframe or
+  delta) is then run-length encoded.  Everything lives in a fixed-size
+  arena used as a ring; when it's full, the oldest captures are discarded.
+
+  @author  Stella team
+  @version $Id$
+*/
+class RewindBuffer
+{
+  public:
+    /**
+      Create a new rewind buffer, initially without any memory.
+    */
+    RewindBuffer();
+
+    /**
+      Destructor
+    */
+    virtual ~RewindBuffer();
+
+  public:
+    /**
+      Set the amount of memory to use and how often to capture a state.
+      This discards any history.
+
+      @param budget    The size of the arena, in bytes
+      @param interval  The number of frames between captured states
+    */
+    void setup(uInt32 budget, uInt32 interval);
+
+    /**
+      Discard all history; the next frame recorded becomes frame 0.
+    */
+    void clear();
+
+    /**
+      Record the frame about to be emulated.  This should be called once
+      per frame, after the input for the frame has been set in the
+      controllers and switches, and before the frame is emulated.
+
+      @param console  The console being recorded
+      @return  False on any errors, else true
+    */
+    bool record(const Console& console);
+
+    /**
+      Restore the console to the start of the given frame, with the input
+      recorded for that frame applied.  The history isn't changed.
+
+      @param console  The console being recorded
+      @param frame    The frame to go to, from firstFrame() to lastFrame()
+      @return  False if the frame isn't available or on any errors
+    */
+    bool seek(Console& console, uInt32 frame);
+
+    /**
+      Discard all history after the start of the given frame, so that
+      recording continues from there (normally after seeking).
+
+      @param frame  The frame to continue from
+      @return  False if the frame isn't available, else true
+    */
+    bool truncate(uInt32 frame);
+
+    /**
+      Answers the oldest frame that can be reached.
+    */
+    uInt32 firstFrame() const;
+
+    /**
+      Answers the frame that will be recorded next.
+    */
+    uInt32 lastFrame() const { return myFrame; }
+
+    /**
+      Answers the number of bytes of the arena currently holding history.
+    */
+    uInt32 memoryUsed() const;
+
+  private:
+    // Information about one captured state and the input that follows it
+    struct Segment {
+      uInt32 offset;       // Position in the arena
+      uInt32 stateLength;  // Bytes of encoded state (inputs follow)
+      uInt32 rawLength;    // Bytes of the state once decoded
+      uInt32 frame;        // Frame at which the state was captured
+      uInt32 frames;       // Number of frames of input following it
+      uInt32 inputLength;  // Bytes of input for all those frames
+      uInt32 keyDistance;  // Captures since the last keyframe (0 = keyframe)
+
+      uInt32 length() const { return stateLength + inputLength; }
+    };
+    typedef Common::Array<Segment> SegmentList;
+
+    // A simple growable block of bytes
+    struct Buffer {
+      uInt8* data;
+      uInt32 size;
+      uInt32 capacity;
+
+      Buffer() : data(0), size(0), capacity(0) { }
+      ~Buffer() { delete[] data; }
+
+      void reserve(uInt32 length);
+      void resize(uInt32 length) { reserve(length); size = length; }
+      void append(const uInt8* bytes, uInt32 length);
+      void append(uInt8 byte)
+      {
+        if(size == capacity) reserve(size + 1);
+        data[size++] = byte;
+      }
+    };
+
+    enum {
+      kKeyframeInterval = 8
+    };
+
+    // How an analog pin is stored in the input log
+    enum {
+      kAnalogMaximum = 0,  // At Controller::maximumResistance
+      kAnalogMinimum = 1,  // At Controller::minimumResistance
+      kAnalogValue   = 2   // Anything else; the value follows
+    };
+
+    /**
+      Move the segment being built into the arena, discarding the oldest
+      history to make room for it.
+    */
+    void commitPending();
+
+    /**
+      Make the given segment in the arena the one being built, discarding
+      every segment after it.
+    */
+    void reopenSegment(int index);
+
+    /**
+      Decode the state stored in the given segment (or the pending segment
+      if index is -1) into myState.
+    */
+    void decodeState(int index);
+
+    /**
+      Append the input for the current frame to the pending segment.
+    */
+    void saveInput(const Console& console);
+
+    /**
+      Apply a frame of recorded input to the console.
+
+      @return  The start of the next frame's input
+    */
+    static const uInt8* loadInput(Console& console, const uInt8* in);
+
+    /**
+      Answers the start of the next frame's input, without applying any.
+    */
+    static const uInt8* skipInput(const uInt8* in);
+
+    /**
+      Get the bytes of the given segment (or of the pending segment if
+      index is -1).
+    */
+    const uInt8* segmentData(int index) const;
+    const Segment& segment(int index) const;
+
+    /**
+      Run-length encode 'length' bytes of (data XOR base) into out.  Bytes
+      of data beyond baseLength are taken as is.
+    */
+    static void encode(Buffer& out, const uInt8* data, uInt32 length,
+                       const uInt8* base, uInt32 baseLength);
+
+    /**
+      Undo encode(), XOR'ing the result into 'data' (which must initially
+      hold the base, padded with zeros to 'length' bytes).
+    */
+    static void decode(uInt8* data, uInt32 length, const uInt8* in);
+
+    // Copy constructor isn't supported by this class so make it private
+    RewindBuffer(const RewindBuffer&);
+
+    // Assignment operator isn't supported by this class so make it private
+    RewindBuffer& operator = (const RewindBuffer&);
+
+  private:
+    // The memory holding all committed segments, used as a ring
+    uInt8* myArena;
+    uInt32 myBudget;
+
+    // Where the next segment will be placed in the arena
+    uInt32 myHead;
+
+    // Committed segments, oldest first; the first is always a keyframe
+    SegmentList mySegments;
+
+    // The segment currently being built, and its encoded contents
+    Segment myPending;
+    Buffer myPendingData;
+    bool myHasPending;
+
+    // Number of frames between captured states
+    uInt32 myInterval;
+
+    // The frame that will be recorded next
+    uInt32 myFrame;
+
+    // The decoded state of the last keyframe, used to build deltas
+    Buffer myKeyState;
+
+    // Scratch buffers for capturing and decoding states
+    Serializer myCapture;
+    Buffer myState;
+};
+
+#endif
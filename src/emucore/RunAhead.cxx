@@ -0,0 +1,98 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include "Console.hxx"
+#include "Control.hxx"
+#include "Sound.hxx"
+#include "Switches.hxx"
+#include "TIA.hxx"
+
+#include "RunAhead.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RunAhead::RunAhead(Console& console, uInt32 frames, Console* second,
+                   Sound* secondSound)
+  : myConsole(console),
+    myFrames(frames > 0 ? frames : 1),
+    mySecond(second),
+    mySecondSound(secondSound)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RunAhead::~RunAhead()
+{
+  delete mySecond;
+  delete mySecondSound;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RunAhead::update()
+{
+  // The real frame is never shown, so there's no need to draw it
+  TIA& tia = myConsole.tia();
+  tia.setRenderSkip(true);
+  tia.update();
+  tia.setRenderSkip(false);
+
+  myState.reset();
+  if(!myConsole.save(myState))
+    return;
+
+  Console& ahead = mySecond ? *mySecond : myConsole;
+  if(mySecond)
+  {
+    // Bring the second console up to date, including the controllers
+    // (which aren't part of the console state)
+    myInput.reset();
+    myConsole.controller(Controller::Left).save(myInput);
+    myConsole.controller(Controller::Right).save(myInput);
+    myConsole.switches().save(myInput);
+
+    myReader.open(myState.data(), myState.size());
+    if(!mySecond->load(myReader))
+      return;
+    myReader.open(myInput.data(), myInput.size());
+    mySecond->controller(Controller::Left).load(myReader);
+    mySecond->controller(Controller::Right).load(myReader);
+    mySecond->switches().load(myReader);
+  }
+
+  // Only the last frame ahead is drawn
+  TIA& aheadTIA = ahead.tia();
+  for(uInt32 i = 1; i <= myFrames; ++i)
+  {
+    aheadTIA.setRenderSkip(i < myFrames);
+    aheadTIA.update();
+  }
+  aheadTIA.setRenderSkip(false);
+
+  // Go back to where the real frame ended; the frame buffer isn't part
+  // of the state, so it still holds the frame from the future
+  if(!mySecond)
+  {
+    myReader.open(myState.data(), myState.size());
+    myConsole.load(myReader);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const TIA& RunAhead::tia() const
+{
+  return mySecond ? mySecond->tia() : myConsole.tia();
+}
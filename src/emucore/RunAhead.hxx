@@ -0,0 +1,109 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef RUN_AHEAD_HXX
+#define RUN_AHEAD_HXX
+
+class Console;
+class Sound;
+class TIA;
+
+#include "bspf.hxx"
+#include "Deserializer.hxx"
+#include "Serializer.hxx"
+
+/**
+  This class implements run-ahead, which hides the input lag built into
+  most games (which only react to the controllers one or two frames after
+  reading them).  Each frame, the console is emulated as usual, and then
+  emulated a few frames further using the current input; the last of
+  those frames is the one shown.  The extra frames are then thrown away.
+
+  There are two ways of doing this.  With a single console, its state is
+  saved after the real frame, and restored once the frames ahead have been
+  emulated.  Restoring the state also resets the sound, so the audio isn't
+  clean.  With a second console, the state of the real console is copied
+  into the second one, which does the running ahead; the real console is
+  never rewound, so its audio is unaffected.
+
+  @author  Stella team
+  @version $Id$
+*/
+class RunAhead
+{
+  public:
+    /**
+      Create a new run-ahead object for the given console.
+
+      @param console      The console being emulated
+      @param frames       The number of frames to run ahead (at least 1)
+      @param second       An optional second console for the same ROM,
+                          used to run ahead; this object takes ownership
+      @param secondSound  The sound object used by the second console;
+                          this object takes ownership
+    */
+    RunAhead(Console& console, uInt32 frames, Console* second = 0,
+             Sound* secondSound = 0);
+
+    /**
+      Destructor
+    */
+    virtual ~RunAhead();
+
+  public:
+    /**
+      Emulate one frame of the console, and then run ahead.  This is
+      used in place of TIA::update().
+    */
+    void update();
+
+    /**
+      Answers the TIA holding the frame that should be shown.
+    */
+    const TIA& tia() const;
+
+    /**
+      Answers the number of frames being run ahead.
+    */
+    uInt32 frames() const { return myFrames; }
+
+  private:
+    // Copy constructor isn't supported by this class so make it private
+    RunAhead(const RunAhead&);
+
+    // Assignment operator isn't supported by this class so make it private
+    RunAhead& operator = (const RunAhead&);
+
+  private:
+    // The console being emulated
+    Console& myConsole;
+
+    // The number of frames to run ahead
+    uInt32 myFrames;
+
+    // The console used to run ahead, if any, and its sound object
+    Console* mySecond;
+    Sound* mySecondSound;
+
+    // Holds the state of the console, and the state of its controllers
+    Serializer myState;
+    Serializer myInput;
+    Deserializer myReader;
+};
+
+#endif
@@ -16,10 +16,15 @@
 // $Id: Serializer.cxx,v 1.14 2009-01-01 18:13:37 stephena Exp $
 //============================================================================
 
+#include <cstring>
+
 #include "Serializer.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Serializer::Serializer(void)
+  : myBuffer(0),
+    mySize(0),
+    myCapacity(0)
 {
 }
 
@@ -27,6 +32,7 @@ Serializer::Serializer(void)
 Serializer::~Serializer(void)
 {
   close();
+  delete[] myBuffer;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -41,47 +47,45 @@ bool Serializer::open(const string& fileName)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::close(void)
 {
-  myStream.close();
+  if(myStream.is_open())
+  {
+    flush();
+    myStream.close();
+  }
   myStream.clear();
+  mySize = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Serializer::isOpen(void)
 {
-  return myStream.is_open();
+  // Only a file that failed to open leaves the stream in a failed state
+  return myStream.is_open() || !myStream.fail();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Serializer::putByte(char value)
+bool Serializer::flush(void)
 {
-  char buf[1];
-  buf[0] = value;
-  myStream.write(buf, 1);
-  if(myStream.bad())
-    throw "Serializer: file write failed";
-}
+  if(!myStream.is_open())
+    return true;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void Serializer::putInt(int value)
-{
-  unsigned char buf[4];
-  for(int i = 0; i < 4; ++i)
-    buf[i] = (value >> (i<<3)) & 0xff;
+  myStream.write((char*)myBuffer, (streamsize)mySize);
+  myStream.flush();
+  mySize = 0;
 
-  myStream.write((char*)buf, 4);
-  if(myStream.bad())
-    throw "Serializer: file write failed";
+  return !myStream.bad();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putString(const string& str)
 {
-  int len = str.length();
-  putInt(len);
-  myStream.write(str.data(), (streamsize)len);
+  uInt32 len = str.length();
+  putInt((int)len);
 
-  if(myStream.bad())
-    throw "Serializer: file write failed";
+  if(mySize + len > myCapacity)
+    grow(len);
+  memcpy(myBuffer + mySize, str.data(), len);
+  mySize += len;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -89,3 +93,21 @@ void Serializer::putBool(bool b)
 {
   putByte(b ? TruePattern: FalsePattern);
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Serializer::grow(uInt32 bytes)
+{
+  // Double the buffer each time, so a complete state is written with
+  // only a handful of allocations (and none once the buffer is reused)
+  uInt32 capacity = myCapacity > 0 ? myCapacity : 4096;
+  while(capacity < mySize + bytes)
+    capacity <<= 1;
+
+  uInt8* buffer = new uInt8[capacity];
+  if(mySize > 0)
+    memcpy(buffer, myBuffer, mySize);
+  delete[] myBuffer;
+
+  myBuffer   = buffer;
+  myCapacity = capacity;
+}
@@ -31,6 +31,11 @@
   (32-bit), strings are written as characters prepended by the length of the
   string, boolean values are written using a special character pattern.
 
+  All data is first collected in a growable memory buffer.  A Serializer
+  which hasn't been opened on a file can be used directly as an in-memory
+  snapshot (see data() and size()); one opened on a file writes the buffer
+  to it in a single operation when flushed or closed.
+
   @author  Stephen Anthony
   @version $Id: Serializer.hxx,v 1.15 2009-01-01 18:13:37 stephena Exp $
 */
@@ -40,8 +45,8 @@ class Serializer
     /**
       Creates a new Serializer device.
 
-      Open must be called with a valid file before this Serializer can
-      be used.
+      The Serializer is ready to be used as a memory buffer right away;
+      open may be called to send the serialized data to a file instead.
     */
     Serializer(void);
 
@@ -61,28 +66,69 @@ class Serializer
     bool open(const string& fileName);
 
     /**
-      Closes the current output stream.
+      Closes the current output stream, writing any data not yet flushed.
+      The Serializer reverts to being an (empty) memory buffer.
     */
     void close(void);
 
     /**
-      Answers whether the serializer is currently opened
+      Answers whether the serializer is currently opened.  A Serializer
+      that isn't using a file is always open.
     */
     bool isOpen(void);
 
+    /**
+      Writes any buffered data to the output file.  This does nothing
+      when the Serializer isn't using a file.
+
+      @return False if the data couldn't be written, else true
+    */
+    bool flush(void);
+
+    /**
+      Discards everything written so far, so the buffer can be reused
+      for another snapshot without reallocating it.
+    */
+    void reset(void) { mySize = 0; }
+
+    /**
+      Get the data written so far (and not yet flushed to a file).
+    */
+    const uInt8* data(void) const { return myBuffer; }
+
+    /**
+      Get the number of bytes written so far (and not yet flushed to a file).
+    */
+    uInt32 size(void) const { return mySize; }
+
     /**
       Writes an byte value (8-bit) to the current output stream.
 
       @param value The byte value to write to the output stream.
     */
-    void putByte(char value);
+    void putByte(char value)
+    {
+      if(mySize == myCapacity)
+        grow(1);
+      myBuffer[mySize++] = (uInt8) value;
+    }
 
     /**
       Writes an int value (32-bit) to the current output stream.
 
       @param value The int value to write to the output stream.
     */
-    void putInt(int value);
+    void putInt(int value)
+    {
+      if(mySize + 4 > myCapacity)
+        grow(4);
+      uInt8* buf = myBuffer + mySize;
+      buf[0] = value & 0xff;
+      buf[1] = (value >> 8) & 0xff;
+      buf[2] = (value >> 16) & 0xff;
+      buf[3] = (value >> 24) & 0xff;
+      mySize += 4;
+    }
 
     /**
       Writes a string to the current output stream.
@@ -99,9 +145,24 @@ class Serializer
     void putBool(bool b);
 
   private:
-    // The stream to send the serialized data to.
+    /**
+      Enlarge the buffer so that at least 'bytes' more bytes fit.
+    */
+    void grow(uInt32 bytes);
+
+    // Copy constructor and assignment operator not supported
+    Serializer(const Serializer&);
+    Serializer& operator = (const Serializer&);
+
+  private:
+    // The stream to send the serialized data to (if any).
     fstream myStream;
 
+    // The serialized data not yet sent to the stream
+    uInt8* myBuffer;
+    uInt32 mySize;
+    uInt32 myCapacity;
+
     enum {
       TruePattern  = 0xfe,
       FalsePattern = 0x01
@@ -23,17 +23,19 @@
 
 #include "bspf.hxx"
 
-#include "OSystem.hxx"
+#include "Frontend.hxx"
 #include "Version.hxx"
 
 #include "Settings.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Settings::Settings(OSystem* osystem)
-  : myOSystem(osystem)
+Settings::Settings(Frontend* frontend)
+  : myFrontend(frontend)
 {
-  // Add this settings object to the OSystem
-  myOSystem->attach(this);
+  // Add this settings object to the frontend (if any; the headless
+  // core library uses settings without one)
+  if(myFrontend)
+    myFrontend->attach(this);
 
   // Add options that are common to all versions of Stella
   setInternal("video", "soft");
@@ -64,6 +66,7 @@ Settings::Settings(OSystem* osystem)
   // Sound options
   setInternal("sound", "true");
   setInternal("fragsize", "512");
+  setInternal("latency", "0");
 #ifdef WII
   setInternal("freq", "32000");
   setInternal("tiafreq", "32000");
@@ -81,6 +84,7 @@ Settings::Settings(OSystem* osystem)
   setInternal("joyhatmap", "");
   setInternal("joydeadzone", "0");
   setInternal("pspeed", "6");
+  setInternal("mpaddle", "-1");
   setInternal("sa1", "left");
   setInternal("sa2", "right");
 
@@ -99,6 +103,7 @@ Settings::Settings(OSystem* osystem)
   setInternal("cheatfile", "");
   setInternal("palettefile", "");
   setInternal("propsfile", "");
+  setInternal("detectfile", "");
   setInternal("eepromdir", "");
 
   // ROM browser options
@@ -116,6 +121,13 @@ Settings::Settings(OSystem* osystem)
 
   // Misc options
   setInternal("autoslot", "false");
+  setInternal("rewind", "false");
+  setInternal("rewindsize", "1024");
+  setInternal("rewindrate", "10");
+  setInternal("runahead", "0");
+  setInternal("runaheadmode", "dual");
+  setInternal("hashlog", "false");
+  setInternal("perfcsv", "");
   setInternal("showinfo", "false");
   setInternal("tiafloat", "true");
   setInternal("avoxport", "");
@@ -136,7 +148,10 @@ void Settings::loadConfig()
   string line, key, value;
   string::size_type equalPos, garbage;
 
-  ifstream in(myOSystem->configFile().c_str());
+  if(!myFrontend)
+    return;
+
+  ifstream in(myFrontend->configFile().c_str());
   if(!in || !in.is_open())
   {
     cout << "ERROR: Couldn't load settings file\n";
@@ -261,6 +276,9 @@ void Settings::validate()
   i = getInt("tiafreq");
   if(i < 0 || i > 48000)
     setInternal("tiafreq", "31400");
+  i = getInt("latency");
+  if(i < 0 || i > 1000)
+    setInternal("latency", "0");
 #endif
 
   i = getInt("joydeadzone");
@@ -275,6 +293,10 @@ void Settings::validate()
   else if(i > 15)
     setInternal("pspeed", "15");
 
+  i = getInt("mpaddle");
+  if(i < -1 || i > 3)
+    setInternal("mpaddle", "-1");
+
   s = getString("palette");
   if(s != "standard" && s != "z26" && s != "user")
     setInternal("palette", "standard");
@@ -335,6 +357,7 @@ void Settings::usage()
   #ifdef SOUND_SUPPORT
     << "  -sound        <1|0>          Enable sound generation\n"
     << "  -fragsize     <number>       The size of sound fragments (must be a power of two)\n"
+    << "  -latency      <number>       Keep the given number of msec of sound queued (0 to auto-calculate)\n"
     << "  -freq         <number>       Set sound sample output frequency (0 - 48000)\n"
     << "  -tiafreq      <number>       Set sound sample generation frequency (0 - 48000)\n"
     << "  -volume       <number>       Set the volume (0 - 100)\n"
@@ -345,9 +368,17 @@ void Settings::usage()
     << "  -showinfo     <1|0>          Shows some game info on commandline\n"
     << "  -joydeadzone  <number>       Sets 'deadzone' area for analog joysticks (0-29)\n"
     << "  -pspeed       <number>       Speed of digital emulated paddle movement (1-15)\n"
+    << "  -mpaddle      <number>       Mouse emulates paddle number (0-3, -1 for ROM default)\n"
     << "  -sa1          <left|right>   Stelladaptor 1 emulates specified joystick port\n"
     << "  -sa2          <left|right>   Stelladaptor 2 emulates specified joystick port\n"
     << "  -autoslot     <1|0>          Automatically switch to next save slot when state saving\n"
+    << "  -rewind       <1|0>          Record recent history so it can be rewound (Alt-r)\n"
+    << "  -rewindsize   <number>       Memory to use for rewind history, in KB\n"
+    << "  -rewindrate   <number>       Number of frames between rewind snapshots\n"
+    << "  -runahead     <number>       Number of frames to run ahead to hide input lag\n"
+    << "  -runaheadmode <single|dual>  Run ahead on the console itself, or on a second one\n"
+    << "  -hashlog      <1|0>          Log frame hashes with movies, and check them on playback\n"
+    << "  -perfcsv      <file>         Write the performance counters of every frame to a CSV file\n"
     << "  -audiofirst   <1|0>          Initial audio before video (required for some ATI video cards)\n"
     << "  -ssdir        <path>         The directory to save snapshot files to\n"
     << "  -sssingle     <1|0>          Generate single snapshot instead of many\n"
@@ -369,6 +400,7 @@ void Settings::usage()
     << "  -cheatfile    <file>         Full pathname of cheatfile database\n"
     << "  -palettefile  <file>         Full pathname of user-defined palette file\n"
     << "  -propsfile    <file>         Full pathname of ROM properties file\n"
+    << "  -detectfile   <file>         Full pathname of autodetection cache file\n"
     << "  -eepromdir    <dir>          Directory in which to save EEPROM files\n"
     << "  -avoxport     <name>         The name of the serial port where an AtariVox is connected\n"
     << "  -help                        Show the text you're now reading\n"
@@ -422,10 +454,10 @@ void Settings::saveConfig()
     }
   }
 
-  if(!settingsChanged)
+  if(!settingsChanged || !myFrontend)
     return;
 
-  ofstream out(myOSystem->configFile().c_str());
+  ofstream out(myFrontend->configFile().c_str());
   if(!out || !out.is_open())
   {
     cout << "ERROR: Couldn't save settings file\n";
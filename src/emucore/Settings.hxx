@@ -19,7 +19,7 @@
 #ifndef SETTINGS_HXX
 #define SETTINGS_HXX
 
-class OSystem;
+class Frontend;
 
 #include "Array.hxx"
 #include "bspf.hxx"
@@ -35,8 +35,11 @@ class Settings
   public:
     /**
       Create a new settings abstract class
+
+      @param frontend The frontend owning these settings, or NULL if
+                      there's none (the config file is then never used)
     */
-    Settings(OSystem* osystem);
+    Settings(Frontend* frontend);
 
     /**
       Destructor
@@ -173,8 +176,8 @@ class Settings
     }
 
   protected:
-    // The parent OSystem object
-    OSystem* myOSystem;
+    // The parent frontend (the OSystem), if any
+    Frontend* myFrontend;
 
     // Structure used for storing settings
     struct Setting
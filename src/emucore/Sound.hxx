@@ -134,6 +134,13 @@ class Sound
     */
     virtual void adjustVolume(Int8 direction) = 0;
 
+    /**
+      Answers the total host time spent generating samples, in
+      microseconds (this wraps around, so only use the difference
+      between two values).
+    */
+    virtual uInt32 processingTime() const { return 0; }
+
   public:
     /**
       Loads the current state of this device from the given Deserializer.
@@ -24,20 +24,20 @@
 #include "Settings.hxx"
 #include "Console.hxx"
 #include "Control.hxx"
+#include "Sound.hxx"
 #include "Switches.hxx"
 #include "System.hxx"
 
 #include "StateManager.hxx"
 
-#define STATE_HEADER "02060000state"
-#define MOVIE_HEADER "02060000movie"
+#define STATE_HEADER "02060001state"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 StateManager::StateManager(OSystem* osystem)
   : myOSystem(osystem),
     myCurrentSlot(0),
     myActiveMode(kOffMode),
-    myFrameCounter(0)
+    myRewindFrame(0)
 {
   reset();
 }
@@ -61,25 +61,13 @@ bool StateManager::toggleRecordMode()
     myActiveMode = kOffMode;
 
     string moviefile = /*myOSystem->baseDir() + BSPF_PATH_SEPARATOR +*/ "test.inp";
-    if(myMovieWriter.isOpen())
-      myMovieWriter.close();
-    if(!myMovieWriter.open(moviefile))
+    if(!myMovie.startRecording(moviefile, myOSystem->console()))
       return false;
 
-    // Prepend the ROM md5 so this state file only works with that ROM
-    myMovieWriter.putString(myOSystem->console().properties().get(Cartridge_MD5));
-
-    if(!myOSystem->console().save(myMovieWriter))
-      return false;
-
-    // Save controller types for this ROM
-    // We need to check this, since some controllers save more state than
-    // normal, and those states files wouldn't be compatible with normal
-    // controllers.
-    myMovieWriter.putString(
-      myOSystem->console().controller(Controller::Left).name());
-    myMovieWriter.putString(
-      myOSystem->console().controller(Controller::Right).name());
+    // Keep the hash of every frame, to check the playback against later
+    string hashfile = myOSystem->baseDir() + BSPF_PATH_SEPARATOR + "test.hsh";
+    if(myOSystem->settings().getBool("hashlog"))
+      myHashLog.startLogging(hashfile, myOSystem->console());
 
     // If we get this far, we're really in movie record mode
     myActiveMode = kMovieRecordMode;
@@ -87,7 +75,10 @@ bool StateManager::toggleRecordMode()
   else  // Turn off movie record mode
   {
     myActiveMode = kOffMode;
-    myMovieWriter.close();
+    if(myHashLog.isLogging() && myMovie.frame() > 0)
+      myHashLog.log(myOSystem->console());
+    myMovie.stopRecording();
+    myHashLog.close();
     return false;
   }
 
@@ -95,67 +86,114 @@ bool StateManager::toggleRecordMode()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool StateManager::toggleRewindMode()
+bool StateManager::togglePlaybackMode()
 {
-  // FIXME - For now, I'm going to use this to activate movie playback
-
-  // Close the writer, since we're about to re-open in read mode
-  myMovieWriter.close();
+  // Finish any recording, since we're about to re-open it for playback
+  if(myMovie.isRecording())
+    myMovie.stopRecording();
+  myHashLog.close();
 
   if(myActiveMode != kMoviePlaybackMode)  // Turn on movie playback mode
   {
     myActiveMode = kOffMode;
 
     string moviefile = /*myOSystem->baseDir() + BSPF_PATH_SEPARATOR +*/ "test.inp";
-    if(myMovieReader.isOpen())
-      myMovieReader.close();
-    if(!myMovieReader.open(moviefile))
+    if(!myMovie.startPlayback(moviefile, myOSystem->console()))
       return false;
 
-    // Check the ROM md5
-    if(myMovieReader.getString() !=
-       myOSystem->console().properties().get(Cartridge_MD5))
-      return false;
-
-    if(!myOSystem->console().load(myMovieReader))
-      return false;
-
-    // Check controller types
-    const string& left  = myMovieReader.getString();
-    const string& right = myMovieReader.getString();
-
-    if(left != myOSystem->console().controller(Controller::Left).name() ||
-       right != myOSystem->console().controller(Controller::Right).name())
-      return false;
+    // Check every frame against the hashes logged while recording (if any)
+    string hashfile = myOSystem->baseDir() + BSPF_PATH_SEPARATOR + "test.hsh";
+    if(myOSystem->settings().getBool("hashlog"))
+      myHashLog.startVerifying(hashfile, myOSystem->console());
 
-    // If we get this far, we're really in movie record mode
+    // If we get this far, we're really in movie playback mode
     myActiveMode = kMoviePlaybackMode;
   }
   else  // Turn off movie playback mode
   {
     myActiveMode = kOffMode;
-    myMovieReader.close();
+    myMovie.stopPlayback();
+    myHashLog.close();
     return false;
   }
 
   return myActiveMode == kMoviePlaybackMode;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StateManager::toggleRewindMode()
+{
+  if(myActiveMode == kRewindRecordMode)  // Start rewinding
+  {
+    // Frames are re-emulated while going backwards, so keep them quiet
+    myRewindFrame = myRewind.lastFrame();
+    myOSystem->sound().mute(true);
+    myActiveMode = kRewindPlaybackMode;
+  }
+  else if(myActiveMode == kRewindPlaybackMode)  // Continue from here
+  {
+    // The last frame we went back to has been emulated since
+    myRewind.truncate(myRewindFrame + 1);
+    myOSystem->sound().mute(false);
+    myActiveMode = kRewindRecordMode;
+  }
+
+  return myActiveMode == kRewindPlaybackMode;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void StateManager::update()
 {
   switch(myActiveMode)
   {
     case kMovieRecordMode:
-      myOSystem->console().controller(Controller::Left).save(myMovieWriter);
-      myOSystem->console().controller(Controller::Right).save(myMovieWriter);
-      myOSystem->console().switches().save(myMovieWriter);
+      // The hashes are of the frame that has just been emulated
+      if(myHashLog.isLogging() && myMovie.frame() > 0)
+        myHashLog.log(myOSystem->console());
+      myMovie.record(myOSystem->console());
       break;
 
     case kMoviePlaybackMode:
-      myOSystem->console().controller(Controller::Left).load(myMovieReader);
-      myOSystem->console().controller(Controller::Right).load(myMovieReader);
-      myOSystem->console().switches().load(myMovieReader);
+      // Stop right after the first frame that's different from the
+      // recording, so it stays on screen
+      if(myHashLog.isVerifying() && myMovie.frame() > 0 &&
+         !myHashLog.verify(myOSystem->console()))
+      {
+        bool diverged = myHashLog.diverged();
+        if(diverged)
+        {
+          ostringstream buf;
+          buf << "Playback differs at frame " << myHashLog.frame();
+          myOSystem->frameBuffer().showMessage(buf.str());
+        }
+        myHashLog.close();
+
+        if(diverged)
+        {
+          myMovie.stopPlayback();
+          myActiveMode = kOffMode;
+          break;
+        }
+      }
+
+      // Hand control back to the player once the movie is over
+      if(!myMovie.play(myOSystem->console()))
+      {
+        myMovie.stopPlayback();
+        myHashLog.close();
+        myActiveMode = kOffMode;
+      }
+      break;
+
+    case kRewindRecordMode:
+      myRewind.record(myOSystem->console());
+      break;
+
+    case kRewindPlaybackMode:
+      // Stay on the oldest frame once there's no more history
+      if(myRewindFrame > myRewind.firstFrame())
+        --myRewindFrame;
+      myRewind.seek(myOSystem->console(), myRewindFrame);
       break;
 
     default:
@@ -191,12 +229,28 @@ void StateManager::loadState(int slot)
 
     // First test if we have a valid header
     // If so, do a complete state load using the Console
-    if(in.getString() != STATE_HEADER)
-      buf << "Incompatible state " << slot << " file";
-    else if(in.getString() == md5 && myOSystem->console().load(in))
-      buf << "State " << slot << " loaded";
-    else
+    // A short or empty file makes the Deserializer throw, which is
+    // reported like any other invalid file
+    try
+    {
+      if(in.getString() != STATE_HEADER)
+        buf << "Incompatible state " << slot << " file";
+      else if(in.getString() == md5 && myOSystem->console().load(in))
+      {
+        buf << "State " << slot << " loaded";
+
+        // The history no longer leads up to the current state
+        if(myActiveMode == kRewindRecordMode)
+          myRewind.clear();
+      }
+      else
+        buf << "Invalid data in state " << slot << " file";
+    }
+    catch(...)
+    {
+      buf.str("");
       buf << "Invalid data in state " << slot << " file";
+    }
 
     in.close();
     myOSystem->frameBuffer().showMessage(buf.str());
@@ -234,7 +288,7 @@ void StateManager::saveState(int slot)
 
     // Do a complete state save using the Console
     buf.str("");
-    if(myOSystem->console().save(out))
+    if(myOSystem->console().save(out) && out.flush())
     {
       buf << "State " << slot << " saved";
       if(myOSystem->settings().getBool("autoslot"))
@@ -270,17 +324,36 @@ void StateManager::reset()
   switch(myActiveMode)
   {
     case kMovieRecordMode:
-      myMovieWriter.close();
+      myMovie.stopRecording();
+      myHashLog.close();
       break;
 
     case kMoviePlaybackMode:
-      myMovieReader.close();
+      myMovie.stopPlayback();
+      myHashLog.close();
+      break;
+
+    case kRewindPlaybackMode:
+      myOSystem->sound().mute(false);
       break;
 
     default:
       break;
   }
   myActiveMode = kOffMode;
+
+  // Rewinding needs a history, so recording starts along with the ROM
+  // (the memory is released again when it's turned off)
+  const Settings& settings = myOSystem->settings();
+  if(settings.getBool("rewind"))
+  {
+    int size = settings.getInt("rewindsize");
+    int rate = settings.getInt("rewindrate");
+    myRewind.setup(size > 0 ? size * 1024 : 0, rate > 0 ? rate : 1);
+    myActiveMode = kRewindRecordMode;
+  }
+  else
+    myRewind.setup(0, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
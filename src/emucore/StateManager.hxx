@@ -23,6 +23,9 @@ class OSystem;
 
 #include "Deserializer.hxx"
 #include "Serializer.hxx"
+#include "HashLog.hxx"
+#include "Movie.hxx"
+#include "RewindBuffer.hxx"
 
 /**
   This class provides an interface to all things related to emulation state.
@@ -52,6 +55,15 @@ class StateManager
     bool isActive();
 
     bool toggleRecordMode();
+    bool togglePlaybackMode();
+
+    /**
+      Starts or stops stepping backwards through the recent history, one
+      frame each time the system is updated.  Rewinding must have been
+      enabled (with the 'rewind' setting) when the ROM was started.
+
+      @return  True if rewinding has been started, else false
+    */
     bool toggleRewindMode();
 
     /**
@@ -112,15 +124,15 @@ class StateManager
     // Whether the manager is in record or playback mode
     Mode myActiveMode;
 
-    // Current frame count (write full state every 60 frames)
-    int myFrameCounter;
+    // The movie being recorded or played back
+    Movie myMovie;
 
-    // MD5 of the currently active ROM (either in movie or rewind mode)
-    string myMD5;
+    // Hashes of the movie frames, to check that playback is identical
+    HashLog myHashLog;
 
-    // Serializer classes used to save/load the eventstream
-    Serializer   myMovieWriter;
-    Deserializer myMovieReader;
+    // Recent history of the console, and the frame shown while rewinding
+    RewindBuffer myRewind;
+    uInt32 myRewindFrame;
 };
 
 #endif
@@ -38,6 +38,11 @@ class Switches : public Serializable
   */
   friend class RiotDebug;
 
+  /**
+    The rewind buffer records and replays the switches of each frame
+  */
+  friend class RewindBuffer;
+
   public:
     /**
       Create a new set of switches using the specified events and
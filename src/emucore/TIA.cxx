@@ -37,6 +37,95 @@
 
 #include "TIA.hxx"
 
+#ifdef TIA_VECTOR_COMPOSITOR
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+
+  typedef __m128i Vector;
+
+  static inline Vector vSplat(uInt8 b)  { return _mm_set1_epi8((char)b); }
+  static inline Vector vAnd(Vector a, Vector b) { return _mm_and_si128(a, b); }
+  static inline Vector vOr(Vector a, Vector b)  { return _mm_or_si128(a, b); }
+  static inline Vector vSelect(Vector m, Vector a, Vector b)
+    { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+  static inline void vStore(uInt8* p, Vector a)
+    { _mm_storeu_si128((__m128i*)p, a); }
+
+  // 0xff in each byte where (p[i] & bits) is nonzero, otherwise 0x00
+  static inline Vector vTest(const uInt8* p, Vector bits)
+  {
+    const Vector zero = _mm_setzero_si128();
+    Vector v = _mm_and_si128(_mm_loadu_si128((const __m128i*)p), bits);
+    return _mm_xor_si128(_mm_cmpeq_epi8(v, zero), _mm_cmpeq_epi8(zero, zero));
+  }
+
+  // Same as above, for 16 consecutive 32-bit masks
+  static inline Vector vTest(const uInt32* p, uInt32 bits)
+  {
+    const Vector zero = _mm_setzero_si128();
+    const Vector b = _mm_set1_epi32((int)bits);
+    const __m128i* q = (const __m128i*)p;
+    Vector a0 = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(q+0), b), zero);
+    Vector a1 = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(q+1), b), zero);
+    Vector a2 = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(q+2), b), zero);
+    Vector a3 = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(q+3), b), zero);
+    Vector v = _mm_packs_epi16(_mm_packs_epi32(a0, a1), _mm_packs_epi32(a2, a3));
+    return _mm_xor_si128(v, _mm_cmpeq_epi8(zero, zero));
+  }
+
+  // OR all 16 bytes together
+  static inline uInt8 vReduceOr(Vector a)
+  {
+    a = _mm_or_si128(a, _mm_srli_si128(a, 8));
+    a = _mm_or_si128(a, _mm_srli_si128(a, 4));
+    a = _mm_or_si128(a, _mm_srli_si128(a, 2));
+    a = _mm_or_si128(a, _mm_srli_si128(a, 1));
+    return (uInt8)_mm_cvtsi128_si32(a);
+  }
+
+#else
+  #include <arm_neon.h>
+
+  typedef uint8x16_t Vector;
+
+  static inline Vector vSplat(uInt8 b)  { return vdupq_n_u8(b); }
+  static inline Vector vAnd(Vector a, Vector b) { return vandq_u8(a, b); }
+  static inline Vector vOr(Vector a, Vector b)  { return vorrq_u8(a, b); }
+  static inline Vector vSelect(Vector m, Vector a, Vector b)
+    { return vbslq_u8(m, a, b); }
+  static inline void vStore(uInt8* p, Vector a) { vst1q_u8(p, a); }
+
+  // 0xff in each byte where (p[i] & bits) is nonzero, otherwise 0x00
+  static inline Vector vTest(const uInt8* p, Vector bits)
+  {
+    return vtstq_u8(vld1q_u8(p), bits);
+  }
+
+  // Same as above, for 16 consecutive 32-bit masks
+  static inline Vector vTest(const uInt32* p, uInt32 bits)
+  {
+    const uint32x4_t b = vdupq_n_u32(bits);
+    uint16x8_t lo = vcombine_u16(vmovn_u32(vtstq_u32(vld1q_u32(p+0), b)),
+                                 vmovn_u32(vtstq_u32(vld1q_u32(p+4), b)));
+    uint16x8_t hi = vcombine_u16(vmovn_u32(vtstq_u32(vld1q_u32(p+8), b)),
+                                 vmovn_u32(vtstq_u32(vld1q_u32(p+12), b)));
+    return vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+  }
+
+  // OR all 16 bytes together
+  static inline uInt8 vReduceOr(Vector a)
+  {
+    uint8x8_t b = vorr_u8(vget_low_u8(a), vget_high_u8(a));
+    uInt32 c = vget_lane_u32(vreinterpret_u32_u8(b), 0) |
+               vget_lane_u32(vreinterpret_u32_u8(b), 1);
+    c |= c >> 16;
+    c |= c >> 8;
+    return (uInt8)c;
+  }
+
+#endif
+#endif
+
 #define HBLANK 68
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -53,11 +142,19 @@ TIA::TIA(Console& console, Sound& sound, Settings& settings)
     myPartialFrameFlag(false),
     myFrameGreyed(false),
     myAutoFrameEnabled(false),
+    myRenderSkipFlag(false),
+    myFrameSkipped(false),
     myFrameCounter(0)
 {
   // Allocate buffers for two frame buffers
   myCurrentFrameBuffer = new uInt8[160 * 300];
   myPreviousFrameBuffer = new uInt8[160 * 300];
+  memset(myScanlineChanged, true, sizeof(myScanlineChanged));
+
+  // The RGBA output is disabled until asked for
+  myRGBABuffer = 0;
+  myRGBAPitch = 0;
+  myRGBAPalette = 0;
 
   // Make sure all TIA bits are enabled
   enableBits(true);
@@ -99,9 +196,6 @@ TIA::TIA(Console& console, Sound& sound, Settings& settings)
     }
   }
 
-  // Compute all of the mask tables
-  TIATables::computeAllTables();
-
   // Zero audio registers
   myAUDV0 = myAUDV1 = myAUDF0 = myAUDF1 = myAUDC0 = myAUDC1 = 0;
 }
@@ -138,6 +232,8 @@ void TIA::reset()
   myHMP0 = myHMP1 = myHMM0 = myHMM1 = myHMBL = 0;
   myVDELP0 = myVDELP1 = myVDELBL = myRESMP0 = myRESMP1 = false;
   myCollision = 0;
+  myCollisionSpanCount = 0;
+  memset(myCollisionCursor, 0, sizeof(myCollisionCursor));
   myPOSP0 = myPOSP1 = myPOSM0 = myPOSM1 = myPOSBL = 0;
 
   // Some default values for the "current" variables
@@ -330,7 +426,7 @@ bool TIA::save(Serializer& out) const
     out.putBool(myVDELBL);
     out.putBool(myRESMP0);
     out.putBool(myRESMP1);
-    out.putInt(myCollision);
+    out.putInt(collisionsInSpans(0, myCollisionSpanCount, myCollision));
     out.putInt(myPOSP0);
     out.putInt(myPOSP1);
     out.putInt(myPOSM0);
@@ -340,13 +436,13 @@ bool TIA::save(Serializer& out) const
     out.putByte((char)myCurrentGRP0);
     out.putByte((char)myCurrentGRP1);
 
-// pointers
-//  myCurrentBLMask = TIATables::BallMaskTable[0][0];
-//  myCurrentM0Mask = TIATables::MissleMaskTable[0][0][0];
-//  myCurrentM1Mask = TIATables::MissleMaskTable[0][0][0];
-//  myCurrentP0Mask = TIATables::PlayerMaskTable[0][0][0];
-//  myCurrentP1Mask = TIATables::PlayerMaskTable[0][0][0];
-//  myCurrentPFMask = TIATables::PlayfieldTable[0];
+    // The current masks are saved as offsets into their tables
+    out.putInt(myCurrentBLMask - &TIATables::BallMaskTable[0][0][0]);
+    saveMissleMask(out, myCurrentM0Mask);
+    saveMissleMask(out, myCurrentM1Mask);
+    out.putInt(myCurrentP0Mask - &TIATables::PlayerMaskTable[0][0][0][0]);
+    out.putInt(myCurrentP1Mask - &TIATables::PlayerMaskTable[0][0][0][0]);
+    out.putInt(myCurrentPFMask - &TIATables::PlayfieldTable[0][0]);
 
     out.putInt(myLastHMOVEClock);
     out.putBool(myHMOVEBlankEnabled);
@@ -428,6 +524,8 @@ bool TIA::load(Deserializer& in)
     myRESMP0 = in.getBool();
     myRESMP1 = in.getBool();
     myCollision = (uInt16) in.getInt();
+    myCollisionSpanCount = 0;
+    memset(myCollisionCursor, 0, sizeof(myCollisionCursor));
     myPOSP0 = (Int16) in.getInt();
     myPOSP1 = (Int16) in.getInt();
     myPOSM0 = (Int16) in.getInt();
@@ -437,13 +535,30 @@ bool TIA::load(Deserializer& in)
     myCurrentGRP0 = (uInt8) in.getByte();
     myCurrentGRP1 = (uInt8) in.getByte();
 
-// pointers
-//  myCurrentBLMask = TIATables::BallMaskTable[0][0];
-//  myCurrentM0Mask = TIATables::MissleMaskTable[0][0][0];
-//  myCurrentM1Mask = TIATables::MissleMaskTable[0][0][0];
-//  myCurrentP0Mask = TIATables::PlayerMaskTable[0][0][0];
-//  myCurrentP1Mask = TIATables::PlayerMaskTable[0][0][0];
-//  myCurrentPFMask = TIATables::PlayfieldTable[0];
+    // The masks are only changed once all of them have been checked, so
+    // a bad state can't leave any pointing outside its table
+    Int32 blOffset = (Int32) in.getInt();
+    uInt8* m0Mask = loadMissleMask(in);
+    uInt8* m1Mask = loadMissleMask(in);
+    Int32 p0Offset = (Int32) in.getInt();
+    Int32 p1Offset = (Int32) in.getInt();
+    Int32 pfOffset = (Int32) in.getInt();
+    if(!isValidMask(blOffset, sizeof(TIATables::BallMaskTable)) ||
+       m0Mask == 0 || m1Mask == 0 ||
+       !isValidMask(p0Offset, sizeof(TIATables::PlayerMaskTable)) ||
+       !isValidMask(p1Offset, sizeof(TIATables::PlayerMaskTable)) ||
+       !isValidMask(pfOffset, sizeof(TIATables::PlayfieldTable) /
+                              sizeof(TIATables::PlayfieldTable[0][0])))
+    {
+      cerr << "Invalid object masks in load state for " << device << endl;
+      return false;
+    }
+    myCurrentBLMask = &TIATables::BallMaskTable[0][0][0] + blOffset;
+    myCurrentM0Mask = m0Mask;
+    myCurrentM1Mask = m1Mask;
+    myCurrentP0Mask = &TIATables::PlayerMaskTable[0][0][0][0] + p0Offset;
+    myCurrentP1Mask = &TIATables::PlayerMaskTable[0][0][0][0] + p1Offset;
+    myCurrentPFMask = &TIATables::PlayfieldTable[0][0] + pfOffset;
 
     myLastHMOVEClock = (Int32) in.getInt();
     myHMOVEBlankEnabled = in.getBool();
@@ -508,9 +623,19 @@ void TIA::update()
 inline void TIA::startFrame()
 {
   // This stuff should only happen at the beginning of a new frame.
-  uInt8* tmp = myCurrentFrameBuffer;
-  myCurrentFrameBuffer = myPreviousFrameBuffer;
-  myPreviousFrameBuffer = tmp;
+  // A skipped frame doesn't draw anything, so the buffers are only swapped
+  // when rendering; that way the current buffer always holds the last
+  // frame that was actually rendered.
+  myFrameSkipped = myRenderSkipFlag;
+  if(!myFrameSkipped)
+  {
+    uInt8* tmp = myCurrentFrameBuffer;
+    myCurrentFrameBuffer = myPreviousFrameBuffer;
+    myPreviousFrameBuffer = tmp;
+
+    // Scanlines are marked unchanged as they're finished (see updateFrame)
+    memset(myScanlineChanged, true, sizeof(myScanlineChanged));
+  }
 
   // Remember the number of clocks which have passed on the current scanline
   // so that we can adjust the frame's starting clock by this amount.  This
@@ -564,6 +689,16 @@ inline void TIA::endFrame()
   // Stats counters
   myFrameCounter++;
 
+  // Scanlines the frame didn't get to (or only partly drew) still hold
+  // an older frame, so convert them too to keep the RGBA output the same
+  // as the frame buffer
+  if(myRGBABuffer && !myFrameSkipped)
+  {
+    uInt32 drawn = (myFramePointer - myCurrentFrameBuffer) / 160;
+    for(uInt32 line = drawn; line < myFrameHeight; ++line)
+      writeRGBAScanline(line);
+  }
+
   // Recalculate framerate. attempting to auto-correct for scanline 'jumps'
   if(myFrameCounter % 32 == 0 && myAutoFrameEnabled)
   {
@@ -680,6 +815,7 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
   if(myVBLANK & 0x02)
   {
     memset(myFramePointer, 0, clocksToUpdate);
+    mySystem->counters().count(PerfCounters::MemsetPixels, clocksToUpdate);
   }
   // Handle all other possible combinations
   else
@@ -693,6 +829,7 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       case 0x00 | PriorityBit | ScoreBit:
       {
         memset(myFramePointer, myCOLUBK, clocksToUpdate);
+        mySystem->counters().count(PerfCounters::MemsetPixels, clocksToUpdate);
         break;
       }
 
@@ -811,9 +948,6 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
             *myFramePointer = (myCurrentGRP0 & *mP0) ? 
                 myCOLUP0 : ((myCurrentGRP1 & *mP1) ? myCOLUP1 : myCOLUBK);
 
-            if((myCurrentGRP0 & *mP0) && (myCurrentGRP1 & *mP1))
-              myCollision |= TIATables::CollisionTable[P0Bit | P1Bit];
-
             ++mP0; ++mP1; ++myFramePointer;
           }
         }
@@ -912,9 +1046,6 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
           {
             *myFramePointer = *mM0 ? myCOLUP0 : (*mM1 ? myCOLUP1 : myCOLUBK);
 
-            if(*mM0 && *mM1)
-              myCollision |= TIATables::CollisionTable[M0Bit | M1Bit];
-
             ++mM0; ++mM1; ++myFramePointer;
           }
         }
@@ -939,9 +1070,6 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
           {
             *myFramePointer = (*mM0 ? myCOLUP0 : (*mBL ? myCOLUPF : myCOLUBK));
 
-            if(*mBL && *mM0)
-              myCollision |= TIATables::CollisionTable[BLBit | M0Bit];
-
             ++mBL; ++mM0; ++myFramePointer;
           }
         }
@@ -966,9 +1094,6 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
           {
             *myFramePointer = (*mBL ? myCOLUPF : (*mM0 ? myCOLUP0 : myCOLUBK));
 
-            if(*mBL && *mM0)
-              myCollision |= TIATables::CollisionTable[BLBit | M0Bit];
-
             ++mBL; ++mM0; ++myFramePointer;
           }
         }
@@ -994,9 +1119,6 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
           {
             *myFramePointer = (*mM1 ? myCOLUP1 : (*mBL ? myCOLUPF : myCOLUBK));
 
-            if(*mBL && *mM1)
-              myCollision |= TIATables::CollisionTable[BLBit | M1Bit];
-
             ++mBL; ++mM1; ++myFramePointer;
           }
         }
@@ -1022,9 +1144,6 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
           {
             *myFramePointer = (*mBL ? myCOLUPF : (*mM1 ? myCOLUP1 : myCOLUBK));
 
-            if(*mBL && *mM1)
-              myCollision |= TIATables::CollisionTable[BLBit | M1Bit];
-
             ++mBL; ++mM1; ++myFramePointer;
           }
         }
@@ -1050,9 +1169,6 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
             *myFramePointer = (myCurrentGRP1 & *mP1) ? myCOLUP1 : 
                 (*mBL ? myCOLUPF : myCOLUBK);
 
-            if(*mBL && (myCurrentGRP1 & *mP1))
-              myCollision |= TIATables::CollisionTable[BLBit | P1Bit];
-
             ++mBL; ++mP1; ++myFramePointer;
           }
         }
@@ -1078,9 +1194,6 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
             *myFramePointer = *mBL ? myCOLUPF : 
                 ((myCurrentGRP1 & *mP1) ? myCOLUP1 : myCOLUBK);
 
-            if(*mBL && (myCurrentGRP1 & *mP1))
-              myCollision |= TIATables::CollisionTable[BLBit | P1Bit];
-
             ++mBL; ++mP1; ++myFramePointer;
           }
         }
@@ -1105,9 +1218,6 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
             *myFramePointer = (myCurrentGRP0 & *mP0) ? 
                   myCOLUP0 : ((myPF & *mPF) ? myCOLUPF : myCOLUBK);
 
-            if((myPF & *mPF) && (myCurrentGRP0 & *mP0))
-              myCollision |= TIATables::CollisionTable[PFBit | P0Bit];
-
             ++mPF; ++mP0; ++myFramePointer;
           }
         }
@@ -1133,9 +1243,6 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
             *myFramePointer = (myPF & *mPF) ? myCOLUPF : 
                 ((myCurrentGRP0 & *mP0) ? myCOLUP0 : myCOLUBK);
 
-            if((myPF & *mPF) && (myCurrentGRP0 & *mP0))
-              myCollision |= TIATables::CollisionTable[PFBit | P0Bit];
-
             ++mPF; ++mP0; ++myFramePointer;
           }
         }
@@ -1161,9 +1268,6 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
             *myFramePointer = (myCurrentGRP1 & *mP1) ? 
                   myCOLUP1 : ((myPF & *mPF) ? myCOLUPF : myCOLUBK);
 
-            if((myPF & *mPF) && (myCurrentGRP1 & *mP1))
-              myCollision |= TIATables::CollisionTable[PFBit | P1Bit];
-
             ++mPF; ++mP1; ++myFramePointer;
           }
         }
@@ -1189,9 +1293,6 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
             *myFramePointer = (myPF & *mPF) ? myCOLUPF : 
                 ((myCurrentGRP1 & *mP1) ? myCOLUP1 : myCOLUBK);
 
-            if((myPF & *mPF) && (myCurrentGRP1 & *mP1))
-              myCollision |= TIATables::CollisionTable[PFBit | P1Bit];
-
             ++mPF; ++mP1; ++myFramePointer;
           }
         }
@@ -1217,9 +1318,6 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
           {
             *myFramePointer = ((myPF & *mPF) || *mBL) ? myCOLUPF : myCOLUBK;
 
-            if((myPF & *mPF) && *mBL)
-              myCollision |= TIATables::CollisionTable[PFBit | BLBit];
-
             ++mPF; ++mBL; ++myFramePointer;
           }
         }
@@ -1231,6 +1329,14 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
       {
         for(; myFramePointer < ending; ++myFramePointer, ++hpos)
         {
+#ifdef TIA_VECTOR_COMPOSITOR
+          if((ending - myFramePointer >= 16) && (hpos >= 80 || hpos + 16 <= 80))
+          {
+            hpos = compositeSpan(ending, hpos);
+            if(myFramePointer == ending)
+              break;
+          }
+#endif
           uInt8 enabled = (myPF & myCurrentPFMask[hpos]) ? PFBit : 0;
 
           if((myEnabledObjects & BLBit) && myCurrentBLMask[hpos])
@@ -1248,7 +1354,6 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
           if((myEnabledObjects & M0Bit) && myCurrentM0Mask[hpos])
             enabled |= M0Bit;
 
-          myCollision |= TIATables::CollisionTable[enabled];
           *myFramePointer = myColor[myPriorityEncoder[hpos < 80 ? 0 : 1]
               [enabled | myPlayfieldPriorityAndScore]];
         }
@@ -1259,9 +1364,246 @@ inline void TIA::updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos)
   myFramePointer = ending;
 }
 
+#ifdef TIA_VECTOR_COMPOSITOR
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TIA::compositeSpan(uInt8* ending, uInt32 hpos)
+{
+  // This must draw exactly the same pixels as the general case in
+  // updateFrameScanline()
+  const Vector blBits = vSplat((myEnabledObjects & BLBit) ? 0xff : 0x00);
+  const Vector m0Bits = vSplat((myEnabledObjects & M0Bit) ? 0xff : 0x00);
+  const Vector m1Bits = vSplat((myEnabledObjects & M1Bit) ? 0xff : 0x00);
+  const Vector grp0 = vSplat(myCurrentGRP0);
+  const Vector grp1 = vSplat(myCurrentGRP1);
+
+  const Vector colubk = vSplat((uInt8)myColor[0]);
+  const Vector colupf = vSplat((uInt8)myColor[1]);
+  const Vector colup0 = vSplat((uInt8)myColor[2]);
+  const Vector colup1 = vSplat((uInt8)myColor[3]);
+  const bool priority = myPlayfieldPriorityAndScore & PriorityBit;
+  const bool score = myPlayfieldPriorityAndScore & ScoreBit;
+
+  do
+  {
+    // Each lane is 0xff where the object is drawn, and 0x00 otherwise
+    Vector pf = vTest(myCurrentPFMask + hpos, myPF);
+    Vector bl = vTest(myCurrentBLMask + hpos, blBits);
+    Vector p0 = vTest(myCurrentP0Mask + hpos, grp0);
+    Vector p1 = vTest(myCurrentP1Mask + hpos, grp1);
+    Vector m0 = vTest(myCurrentM0Mask + hpos, m0Bits);
+    Vector m1 = vTest(myCurrentM1Mask + hpos, m1Bits);
+
+    // Resolve the colors in the same order as myPriorityEncoder
+    Vector pm0 = vOr(p0, m0), pm1 = vOr(p1, m1), pfbl = vOr(pf, bl);
+    Vector color;
+    if(priority)
+    {
+      color = vSelect(pm1, colup1, colubk);
+      color = vSelect(pm0, colup0, color);
+      color = vSelect(pfbl, colupf, color);
+    }
+    else if(score)
+    {
+      // In score mode the playfield takes the color of the player on
+      // that side, which player 1 can't cover on the left half
+      Vector scorepf = (hpos < 80) ? colup0 : colup1;
+      color = vSelect(bl, colupf, colubk);
+      color = vSelect(pf, scorepf, color);
+      color = vSelect(pm1, (hpos < 80) ? vSelect(pf, colup0, colup1) : colup1,
+                      color);
+      color = vSelect(pm0, colup0, color);
+    }
+    else
+    {
+      color = vSelect(pfbl, colupf, colubk);
+      color = vSelect(pm1, colup1, color);
+      color = vSelect(pm0, colup0, color);
+    }
+    vStore(myFramePointer, color);
+
+    myFramePointer += 16;
+    hpos += 16;
+  }
+  while((ending - myFramePointer >= 16) && (hpos >= 80 || hpos + 16 <= 80));
+
+  return hpos;
+}
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::recordCollisionSpan(uInt32 clocksToUpdate, uInt32 hpos)
+{
+  // No collisions are registered in the vertical blank region
+  if(myVBLANK & 0x02)
+    return;
+
+  // The special cases for single objects (and some pairs of objects)
+  // in updateFrameScanline() only look at the objects which are enabled,
+  // while the general case always checks the playfield graphics, even
+  // when the playfield was disabled with enableBit()
+  bool checkPF = true;
+  switch(myEnabledObjects)
+  {
+    case 0x00:
+    case PFBit:
+    case P0Bit:
+    case P1Bit:
+    case M0Bit:
+    case M1Bit:
+    case BLBit:
+      return;  // nothing to collide with
+
+    case P0Bit | P1Bit:
+    case M0Bit | M1Bit:
+    case BLBit | M0Bit:
+    case BLBit | M1Bit:
+    case BLBit | P1Bit:
+      checkPF = false;
+      break;
+
+    default:
+      break;
+  }
+
+  uInt32 pf = checkPF ? myPF : 0;
+  uInt8 shown = (pf ? PFBit : 0) | (myCurrentGRP0 ? P0Bit : 0) |
+                (myCurrentGRP1 ? P1Bit : 0) |
+                (myEnabledObjects & (BLBit | M0Bit | M1Bit));
+
+  // Don't bother with spans which can't set any new collision latches
+  uInt16 possible = TIATables::CollisionTable[shown] & ~myCollision;
+  if(possible == 0)
+    return;
+
+  if(myCollisionSpanCount == kCollisionSpans)
+    resolveCollisions();
+
+  CollisionSpan& span = myCollisionSpans[myCollisionSpanCount++];
+  span.pfMask = myCurrentPFMask + hpos;
+  span.blMask = myCurrentBLMask + hpos;
+  span.p0Mask = myCurrentP0Mask + hpos;
+  span.p1Mask = myCurrentP1Mask + hpos;
+  span.m0Mask = myCurrentM0Mask + hpos;
+  span.m1Mask = myCurrentM1Mask + hpos;
+  span.pf = pf;
+  span.possible = possible;
+  span.grp0 = myCurrentGRP0;
+  span.grp1 = myCurrentGRP1;
+  span.bl = (myEnabledObjects & BLBit) ? 0xff : 0x00;
+  span.m0 = (myEnabledObjects & M0Bit) ? 0xff : 0x00;
+  span.m1 = (myEnabledObjects & M1Bit) ? 0xff : 0x00;
+  span.clocks = clocksToUpdate;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt16 TIA::collisionsInSpans(uInt32 first, uInt32 last,
+                              uInt16 collision) const
+{
+  for(uInt32 i = first; i < last; ++i)
+  {
+    const CollisionSpan& span = myCollisionSpans[i];
+    if((span.possible & ~collision) == 0)
+      continue;
+
+    uInt32 x = 0;
+#ifdef TIA_VECTOR_COMPOSITOR
+    if(span.clocks >= 16)
+    {
+      const Vector blBits = vSplat(span.bl);
+      const Vector m0Bits = vSplat(span.m0);
+      const Vector m1Bits = vSplat(span.m1);
+      const Vector grp0 = vSplat(span.grp0);
+      const Vector grp1 = vSplat(span.grp1);
+      Vector low = vSplat(0), high = vSplat(0);
+
+      for(; x + 16 <= span.clocks; x += 16)
+      {
+        Vector pf = vTest(span.pfMask + x, span.pf);
+        Vector bl = vTest(span.blMask + x, blBits);
+        Vector p0 = vTest(span.p0Mask + x, grp0);
+        Vector p1 = vTest(span.p1Mask + x, grp1);
+        Vector m0 = vTest(span.m0Mask + x, m0Bits);
+        Vector m1 = vTest(span.m1Mask + x, m1Bits);
+
+        // Same bits as TIATables::CollisionTable, split into two bytes
+        low = vOr(low, vOr(
+          vOr(vAnd(m0, vOr(vAnd(p1, vSplat(0x01)), vAnd(p0, vSplat(0x02)))),
+              vAnd(m1, vOr(vAnd(p0, vSplat(0x04)), vAnd(p1, vSplat(0x08))))),
+          vOr(vAnd(p0, vOr(vAnd(pf, vSplat(0x10)), vAnd(bl, vSplat(0x20)))),
+              vAnd(p1, vOr(vAnd(pf, vSplat(0x40)), vAnd(bl, vSplat(0x80)))))));
+        high = vOr(high, vOr(
+          vOr(vAnd(m0, vOr(vOr(vAnd(pf, vSplat(0x01)), vAnd(bl, vSplat(0x02))),
+                            vAnd(m1, vSplat(0x40)))),
+              vAnd(m1, vOr(vAnd(pf, vSplat(0x04)), vAnd(bl, vSplat(0x08))))),
+          vOr(vAnd(vAnd(bl, pf), vSplat(0x10)), vAnd(vAnd(p0, p1), vSplat(0x20)))));
+      }
+      collision |= vReduceOr(low) | (vReduceOr(high) << 8);
+    }
+#endif
+    for(; x < span.clocks; ++x)
+    {
+      uInt8 enabled = (span.pf & span.pfMask[x]) ? PFBit : 0;
+
+      if(span.bl & span.blMask[x])
+        enabled |= BLBit;
+
+      if(span.grp1 & span.p1Mask[x])
+        enabled |= P1Bit;
+
+      if(span.m1 & span.m1Mask[x])
+        enabled |= M1Bit;
+
+      if(span.grp0 & span.p0Mask[x])
+        enabled |= P0Bit;
+
+      if(span.m0 & span.m0Mask[x])
+        enabled |= M0Bit;
+
+      collision |= TIATables::CollisionTable[enabled];
+    }
+  }
+  return collision;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::resolveCollisions()
+{
+  myCollision = collisionsInSpans(0, myCollisionSpanCount, myCollision);
+
+  myCollisionSpanCount = 0;
+  memset(myCollisionCursor, 0, sizeof(myCollisionCursor));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::resolveCollisions(uInt32 reg)
+{
+  static const uInt16 ourRegisterBits[8] = {
+    0x0003, 0x000c, 0x0030, 0x00c0, 0x0300, 0x0c00, 0x1000, 0x6000
+  };
+  uInt16 bits = ourRegisterBits[reg];
+
+  // Since the latches are only ever set, the spans which can't change the
+  // bits read by this register can be ignored until another one is read
+  uInt32 i = myCollisionCursor[reg];
+  for(; i < myCollisionSpanCount && (myCollision & bits) != bits; ++i)
+  {
+    if(myCollisionSpans[i].possible & bits & ~myCollision)
+    {
+      // Every collision in the span is now latched, so the other
+      // registers can skip it
+      myCollision = collisionsInSpans(i, i + 1, myCollision);
+      myCollisionSpans[i].possible = 0;
+    }
+  }
+  myCollisionCursor[reg] = myCollisionSpanCount;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::updateFrame(Int32 clock)
 {
+  PerfCounters& counters = mySystem->counters();
+  counters.count(PerfCounters::FrameUpdates);
+
   // See if we're in the nondisplayable portion of the screen or if
   // we've already updated this portion of the screen
   if((clock < myClockStartDisplay) || 
@@ -1271,6 +1613,9 @@ void TIA::updateFrame(Int32 clock)
     return;
   }
 
+  bool timing = counters.timing();
+  uInt32 start = timing ? PerfCounters::ticks() : 0;
+
   // Truncate the number of cycles to update to the stop display point
   if(clock > myClockStopDisplay)
   {
@@ -1324,7 +1669,15 @@ void TIA::updateFrame(Int32 clock)
     // Update as much of the scanline as we can
     if(clocksToUpdate != 0)
     {
-      updateFrameScanline(clocksToUpdate, clocksFromStartOfScanLine - HBLANK);
+      recordCollisionSpan(clocksToUpdate, clocksFromStartOfScanLine - HBLANK);
+
+      if(myFrameSkipped)
+        myFramePointer += clocksToUpdate;
+      else
+      {
+        counters.count(PerfCounters::Pixels, clocksToUpdate);
+        updateFrameScanline(clocksToUpdate, clocksFromStartOfScanLine - HBLANK);
+      }
     }
 
     // Handle HMOVE blanks if they are enabled
@@ -1332,7 +1685,8 @@ void TIA::updateFrame(Int32 clock)
         (clocksFromStartOfScanLine < (HBLANK + 8)))
     {
       Int32 blanks = (HBLANK + 8) - clocksFromStartOfScanLine;
-      memset(oldFramePointer, 0, blanks);
+      if(!myFrameSkipped)
+        memset(oldFramePointer, 0, blanks);
 
       if((clocksToUpdate + clocksFromStartOfScanLine) >= (HBLANK + 8))
       {
@@ -1340,6 +1694,24 @@ void TIA::updateFrame(Int32 clock)
       }
     }
 
+    // Compare a finished scanline with the one from the previous frame, so
+    // the display doesn't need to look at unchanged ones (the last scanline
+    // of the frame ends without wrapping around to the next one)
+    if((myClocksToEndOfScanLine == 228 || myClocksToEndOfScanLine == 0) &&
+        !myFrameSkipped)
+    {
+      uInt32 offset = myFramePointer - myCurrentFrameBuffer;
+      if(offset >= 160)
+      {
+        offset -= 160;
+        myScanlineChanged[offset / 160] = memcmp(myCurrentFrameBuffer + offset,
+            myPreviousFrameBuffer + offset, 160) != 0;
+
+        if(myRGBABuffer)
+          writeRGBAScanline(offset / 160);
+      }
+    }
+
     // See if we're at the end of a scanline
     if(myClocksToEndOfScanLine == 228)
     {
@@ -1391,6 +1763,32 @@ void TIA::updateFrame(Int32 clock)
     }
   } 
   while(myClockAtLastUpdate < clock);
+
+  if(timing)
+    counters.addTime(PerfCounters::TIA, PerfCounters::ticks() - start);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::writeRGBAScanline(uInt32 line)
+{
+  const uInt8* in = myCurrentFrameBuffer + line * 160;
+  uInt32* out = (uInt32*)(myRGBABuffer + line * myRGBAPitch);
+
+  for(uInt32 x = 0; x < 160; x += 4)
+  {
+    out[x]   = myRGBAPalette[in[x]];
+    out[x+1] = myRGBAPalette[in[x+1]];
+    out[x+2] = myRGBAPalette[in[x+2]];
+    out[x+3] = myRGBAPalette[in[x+3]];
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::setRGBAOutput(uInt32* buffer, uInt32 pitch, const uInt32* palette)
+{
+  myRGBABuffer = (uInt8*)buffer;
+  myRGBAPitch = pitch;
+  myRGBAPalette = palette;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1419,6 +1817,10 @@ void TIA::greyOutFrame()
       tmp >>= 1;
       myCurrentFrameBuffer[ (s - myFrameYStart) * 160 + i] = tmp;
     }
+    myScanlineChanged[s - myFrameYStart] = true;
+
+    if(myRGBABuffer)
+      writeRGBAScanline(s - myFrameYStart);
   }
 }
 
@@ -1453,6 +1855,38 @@ inline uInt8 TIA::dumpedInputPort(int resistance)
   return 0x00;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::saveMissleMask(Serializer& out, const uInt8* mask)
+{
+  bool disabled = mask >= &TIATables::DisabledMaskTable[0] &&
+                  mask < &TIATables::DisabledMaskTable[640];
+  out.putBool(disabled);
+  if(disabled)
+    out.putInt(mask - &TIATables::DisabledMaskTable[0]);
+  else
+    out.putInt(mask - &TIATables::MissleMaskTable[0][0][0][0]);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt8* TIA::loadMissleMask(Deserializer& in)
+{
+  bool disabled = in.getBool();
+  Int32 offset = (Int32) in.getInt();
+  if(disabled)
+    return isValidMask(offset, sizeof(TIATables::DisabledMaskTable)) ?
+           &TIATables::DisabledMaskTable[0] + offset : 0;
+  else
+    return isValidMask(offset, sizeof(TIATables::MissleMaskTable)) ?
+           &TIATables::MissleMaskTable[0][0][0][0] + offset : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TIA::isValidMask(Int32 offset, uInt32 entries)
+{
+  // The masks are read for up to 160 pixels past where they point
+  return offset >= 0 && (uInt32)offset + 160 <= entries;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 TIA::peek(uInt16 addr)
 {
@@ -1463,6 +1897,10 @@ uInt8 TIA::peek(uInt16 addr)
 
   uInt8 value = 0x00;
 
+  // Collisions are only worked out when they're actually read
+  if((addr & 0x000f) <= CXPPMM)
+    resolveCollisions(addr & 0x0007);
+
   switch(addr & 0x000f)
   {
     case CXM0P:
@@ -1545,6 +1983,7 @@ uInt8 TIA::peek(uInt16 addr)
 void TIA::poke(uInt16 addr, uInt8 value)
 {
   addr = addr & 0x003f;
+  mySystem->counters().count(PerfCounters::TIAPokes);
 
   Int32 clock = mySystem->cycles() * 3;
   Int16 delay = TIATables::PokeDelayTable[addr];
@@ -1796,7 +2235,8 @@ void TIA::poke(uInt16 addr, uInt8 value)
       Int32 newx = hpos < HBLANK ? 3 : (((hpos - HBLANK) + 5) % 160);
 
       // Find out under what condition the player is being reset
-      Int8 when = TIATables::PlayerPositionResetWhenTable[myNUSIZ0 & 7][myPOSP0][newx];
+      Int8 when = TIATables::PlayerPositionResetWhenTable[myNUSIZ0 & 7]
+          [(newx - myPOSP0 + 160) % 160];
 
 #ifdef DEBUG_HMOVE
       if((clock - myLastHMOVEClock) < (24 * 3))
@@ -1847,7 +2287,8 @@ void TIA::poke(uInt16 addr, uInt8 value)
       Int32 newx = hpos < HBLANK ? 3 : (((hpos - HBLANK) + 5) % 160);
 
       // Find out under what condition the player is being reset
-      Int8 when = TIATables::PlayerPositionResetWhenTable[myNUSIZ1 & 7][myPOSP1][newx];
+      Int8 when = TIATables::PlayerPositionResetWhenTable[myNUSIZ1 & 7]
+          [(newx - myPOSP1 + 160) % 160];
 
 #ifdef DEBUG_HMOVE
       if((clock - myLastHMOVEClock) < (24 * 3))
@@ -2378,6 +2819,8 @@ void TIA::poke(uInt16 addr, uInt8 value)
     case CXCLR:   // Clear collision latches
     {
       myCollision = 0;
+      myCollisionSpanCount = 0;
+      memset(myCollisionCursor, 0, sizeof(myCollisionCursor));
       break;
     }
 
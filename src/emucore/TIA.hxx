@@ -27,6 +27,12 @@ class Settings;
 #include "Device.hxx"
 #include "System.hxx"
 
+// The general case of the scanline renderer composites 16 pixels at a
+// time on hosts with 128-bit integer vectors (SSE2 or NEON)
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define TIA_VECTOR_COMPOSITOR
+#endif
+
 /**
   This class is a device that emulates the Television Interface Adapator 
   found in the Atari 2600 and 7800 consoles.  The Television Interface 
@@ -156,6 +162,16 @@ class TIA : public Device
     */
     uInt8* previousFrameBuffer() const { return myPreviousFrameBuffer; }
 
+    /**
+      Answers whether the given scanline of the current frame buffer
+      differs from the same scanline of the previous frame buffer.
+      Scanlines which weren't completely drawn in the current frame
+      are always reported as changed.
+
+      @return True if the scanline must be redrawn
+    */
+    bool scanlineChanged(uInt32 line) const { return myScanlineChanged[line]; }
+
     /**
       Answers the width and height of the frame buffer
     */
@@ -170,6 +186,34 @@ class TIA : public Device
     */
     void enableAutoFrame(bool mode) { myAutoFrameEnabled = mode; }
 
+    /**
+      Enables/disables render-skip mode, starting with the next frame.
+      Skipped frames are emulated exactly as usual (including all
+      collisions), but no pixels are written; the frame buffers keep
+      the contents of the last rendered frame.  This is useful for
+      frame-skip and fast-forward, where most frames are never shown.
+
+      @param skip  Whether to skip rendering of the following frames
+    */
+    void setRenderSkip(bool skip) { myRenderSkipFlag = skip; }
+
+    /**
+      Enables/disables writing rendered frames as 32-bit pixels.  As each
+      scanline of a rendered frame is finished, it's mapped through the
+      given palette into the caller's buffer, so frames can be captured or
+      uploaded without another pass over the whole frame buffer.  The
+      buffer must hold height() scanlines of width() pixels each.  When a
+      frame ends early, the scanlines it didn't draw are converted from
+      the frame buffer as it stands, so the output always matches it.
+
+      @param buffer   The first pixel of the frame, or 0 to disable output
+      @param pitch    The distance between the start of each scanline,
+                      in bytes
+      @param palette  The 32-bit pixel for each of the 256 frame buffer
+                      values (a pointer to it is kept, not a copy)
+    */
+    void setRGBAOutput(uInt32* buffer, uInt32 pitch, const uInt32* palette);
+
     /**
       Answers the current color clock we've gotten to on this scanline.
 
@@ -243,9 +287,35 @@ class TIA : public Device
     // Update the current frame buffer up to one scanline
     void updateFrameScanline(uInt32 clocksToUpdate, uInt32 hpos);
 
+    // Remember the objects drawn in part of a scanline, so the collisions
+    // between them can be worked out when the latches are actually read
+    void recordCollisionSpan(uInt32 clocksToUpdate, uInt32 hpos);
+
+    // Answer the given collision latches plus any collisions in the
+    // recorded spans from first up to (but not including) last
+    uInt16 collisionsInSpans(uInt32 first, uInt32 last,
+                             uInt16 collision) const;
+
+    // Update the collision latches with every recorded span
+    void resolveCollisions();
+
+    // Update the collision latches read by the given register (CXM0P to
+    // CXPPMM) with the spans recorded since that register was last read
+    void resolveCollisions(uInt32 reg);
+
+#ifdef TIA_VECTOR_COMPOSITOR
+    // Draw blocks of 16 pixels for the general case of updateFrameScanline,
+    // until fewer than 16 pixels remain or the next block would cross the
+    // middle of the scanline; answers the updated horizontal position
+    uInt32 compositeSpan(uInt8* ending, uInt32 hpos);
+#endif
+
     // Update the current frame buffer to the specified color clock
     void updateFrame(Int32 clock);
 
+    // Write a scanline of the current frame buffer to the RGBA output
+    void writeRGBAScanline(uInt32 line);
+
     // Waste cycles until the current scanline is finished
     void waitHorizontalSync();
 
@@ -264,6 +334,18 @@ class TIA : public Device
     // Convert resistance from ports to dumped value
     uInt8 dumpedInputPort(int resistance);
 
+    // Save a missle mask, which may point into either the missle or the
+    // disabled mask table, as an offset into its table
+    static void saveMissleMask(Serializer& out, const uInt8* mask);
+
+    // Load a missle mask saved by saveMissleMask(), or 0 if its offset
+    // is out of range
+    static uInt8* loadMissleMask(Deserializer& in);
+
+    // Answers whether a saved mask offset leaves a whole scanline of the
+    // mask inside a table of the given number of entries
+    static bool isValidMask(Int32 offset, uInt32 entries);
+
   private:
     // Console the TIA is associated with
     Console& myConsole;
@@ -280,6 +362,15 @@ class TIA : public Device
     // Pointer to the previous frame buffer
     uInt8* myPreviousFrameBuffer;
 
+    // Whether each scanline differs between the current and previous
+    // frame buffers (the buffers hold 300 scanlines)
+    bool myScanlineChanged[300];
+
+    // The buffer, pitch (in bytes) and palette for setRGBAOutput()
+    uInt8* myRGBABuffer;
+    uInt32 myRGBAPitch;
+    const uInt32* myRGBAPalette;
+
     // Pointer to the next pixel that will be drawn in the current frame buffer
     uInt8* myFramePointer;
 
@@ -391,6 +482,30 @@ class TIA : public Device
 
     uInt16 myCollision;   // Collision register
 
+    // The state of the objects for part of a scanline, which is all that's
+    // needed to find the collisions in it
+    struct CollisionSpan
+    {
+      const uInt32* pfMask;
+      const uInt8* blMask;
+      const uInt8* p0Mask;
+      const uInt8* p1Mask;
+      const uInt8* m0Mask;
+      const uInt8* m1Mask;
+      uInt32 pf;
+      uInt16 possible;    // Collisions between the objects which are shown
+      uInt8 grp0, grp1;
+      uInt8 bl, m0, m1;   // 0xff if the object is enabled, 0x00 otherwise
+      uInt8 clocks;
+    };
+
+    // Spans of the frame whose collisions haven't been resolved yet, and
+    // the first span not yet resolved for each collision register
+    enum { kCollisionSpans = 256 };
+    CollisionSpan myCollisionSpans[kCollisionSpans];
+    uInt32 myCollisionSpanCount;
+    uInt32 myCollisionCursor[8];
+
     // Note that these position registers contain the color clock 
     // on which the object's serial output should begin (0 to 159)
     Int16 myPOSP0;        // Player 0 position register
@@ -481,6 +596,11 @@ class TIA : public Device
     // Automatic framerate correction based on number of scanlines
     bool myAutoFrameEnabled;
 
+    // Whether rendering should be skipped, as requested by setRenderSkip(),
+    // and whether it's being skipped for the current frame
+    bool myRenderSkipFlag;
+    bool myFrameSkipped;
+
     // Number of frames displayed by this TIA
     int myFrameCounter;
 
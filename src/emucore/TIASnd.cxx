@@ -19,6 +19,15 @@
 #include "System.hxx"
 #include "TIASnd.hxx"
 
+uInt16 TIASound::ourPolyTable[16][512];
+
+// The table only depends on constants, so build it while the program is
+// starting up (and still single-threaded) instead of in the constructor
+static struct TIASoundTablesInitializer
+{
+  TIASoundTablesInitializer() { TIASound::buildTables(); }
+} ourTIASoundTablesInitializer;
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TIASound::TIASound(Int32 outputFrequency, Int32 tiaFrequency, uInt32 channels)
   : myOutputFrequency(outputFrequency),
@@ -26,8 +35,12 @@ TIASound::TIASound(Int32 outputFrequency, Int32 tiaFrequency, uInt32 channels)
     myChannels(channels),
     myOutputCounter(0),
     myVolumePercentage(100),
-    myVolumeClip(128)
+    myVolumeClip(128),
+    myBlipOffset(0)
 {
+  myDivCounter[0] = myDivCounter[1] = 0;
+
+  resetBandLimited();
   reset();
 }
 
@@ -40,28 +53,34 @@ TIASound::~TIASound()
 void TIASound::reset()
 {
   myAUDC[0] = myAUDC[1] = myAUDF[0] = myAUDF[1] = myAUDV[0] = myAUDV[1] = 0;
-  myP4[0] = myP5[0] = myP4[1] = myP5[1] = 1;
-  myFreqDiv[0].set(0);
-  myFreqDiv[1].set(0);
+  myPolyState[0] = myPolyState[1] = (1 << 4) | 1;  // P5 = P4 = 1
   myOutputCounter = 0;
+
+  myBlip[0].clear();
+  myBlip[1].clear();
+  myBlipLevel[0] = myBlipLevel[1] = 0;
+  myBlipOffset = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASound::outputFrequency(Int32 freq)
 {
   myOutputFrequency = freq;
+  resetBandLimited();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASound::tiaFrequency(Int32 freq)
 {
   myTIAFrequency = freq;
+  resetBandLimited();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASound::channels(uInt32 number)
 {
   myChannels = number == 2 ? 2 : 1;
+  resetBandLimited();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -85,12 +104,10 @@ void TIASound::set(uInt16 address, uInt8 value)
 
     case 0x17:    // AUDF0
       myAUDF[0] = value & 0x1f;
-      myFreqDiv[0].set(myAUDF[0]);
       break;
 
     case 0x18:    // AUDF1
       myAUDF[1] = value & 0x1f;
-      myFreqDiv[1].set(myAUDF[1]);
       break;
 
     case 0x19:    // AUDV0
@@ -141,242 +158,460 @@ void TIASound::volume(uInt32 percent)
     myVolumePercentage = percent;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::buildTables()
+{
+  // Each state holds P5 in bits 8-4 and P4 in bits 3-0; no mode looks at
+  // any other bits of them on the next clock
+  for(uInt32 mode = 0; mode < 16; ++mode)
+  {
+    for(uInt32 state = 0; state < 512; ++state)
+    {
+      uInt8 p4 = state & 0x0f, p5 = state >> 4;
+      clockPolys(mode, p4, p5);
+      ourPolyTable[mode][state] = ((p5 & 0x1f) << 4) | (p4 & 0x0f);
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::resetBandLimited()
+{
+  // The output counter means something else to each way of processing
+  myOutputCounter = 0;
+
+  myBlip[0].setRates(myOutputFrequency, myTIAFrequency);
+  myBlip[1].setRates(myOutputFrequency, myTIAFrequency);
+  myBlipLevel[0] = myBlipLevel[1] = 0;
+  myBlipOffset = 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASound::process(uInt8* buffer, uInt32 samples)
 {
+  if(myOutputFrequency != myTIAFrequency && myOutputFrequency > 0 &&
+     myTIAFrequency > 0)
+  {
+    processBandLimited(buffer, samples);
+    return;
+  }
+
   Int32 v0 = ((myAUDV[0] << 2) * myVolumePercentage) / 100;
   Int32 v1 = ((myAUDV[1] << 2) * myVolumePercentage) / 100;
 
+  // The registers don't change while a fragment is being generated, so
+  // each channel steps through the table for its mode, and its output
+  // (bit 3 of P4) only has to be worked out again when it's clocked.
+  // Everything is kept in locals, since the compiler would otherwise
+  // reload the members after every write to the buffer.
+  const uInt16* poly0 = ourPolyTable[myAUDC[0]];
+  const uInt16* poly1 = ourPolyTable[myAUDC[1]];
+  uInt32 state0 = myPolyState[0], state1 = myPolyState[1];
+  uInt32 divide0 = myAUDF[0], divide1 = myAUDF[1];
+  uInt32 counter0 = myDivCounter[0], counter1 = myDivCounter[1];
+  Int32 out0 = ((state0 >> 3) & 0x01) * v0;
+  Int32 out1 = ((state1 >> 3) & 0x01) * v1;
+  Int32 outputCounter = myOutputCounter;
+  const Int32 outputFrequency = myOutputFrequency;
+  const Int32 tiaFrequency = myTIAFrequency;
+  const Int32 clip = myVolumeClip;
+  const bool stereo = myChannels == 2;
+
   // Loop until the sample buffer is full
   while(samples > 0)
   {
-    // Process both sound channels
-    for(uInt32 c = 0; c < 2; ++c)
+    // Update the polys for each channel if its freq divider outputs a pulse
+    if(++counter0 > divide0)
+    {
+      counter0 = 0;
+      state0 = poly0[state0];
+      out0 = ((state0 >> 3) & 0x01) * v0;
+    }
+    if(++counter1 > divide1)
     {
-      // Update P4 & P5 registers for channel if freq divider outputs a pulse
-      if((myFreqDiv[c].clock()))
+      counter1 = 0;
+      state1 = poly1[state1];
+      out1 = ((state1 >> 3) & 0x01) * v1;
+    }
+
+    outputCounter += outputFrequency;
+
+    while((samples > 0) && (outputCounter >= tiaFrequency))
+    {
+      if(stereo)
       {
-        switch(myAUDC[c])
-        {
-          case 0x00:    // Set to 1
-          {
-            // Shift a 1 into the 4-bit register each clock
-            myP4[c] = (myP4[c] << 1) | 0x01;
-            break;
-          }
-
-          case 0x01:    // 4 bit poly
-          {
-            // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
-            myP4[c] = (myP4[c] & 0x0f) ? 
-                ((myP4[c] << 1) | (((myP4[c] & 0x08) ? 1 : 0) ^
-                ((myP4[c] & 0x04) ? 1 : 0))) : 1;
-            break;
-          }
-
-          case 0x02:    // div 31 -> 4 bit poly
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // This does the divide-by 31 with length 13:18
-            if((myP5[c] & 0x0f) == 0x08)
-            {
-              // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
-              myP4[c] = (myP4[c] & 0x0f) ? 
-                  ((myP4[c] << 1) | (((myP4[c] & 0x08) ? 1 : 0) ^
-                  ((myP4[c] & 0x04) ? 1 : 0))) : 1;
-            }
-            break;
-          }
-
-          case 0x03:    // 5 bit poly -> 4 bit poly
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // P5 clocks the 4 bit poly
-            if(myP5[c] & 0x10)
-            {
-              // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
-              myP4[c] = (myP4[c] & 0x0f) ? 
-                  ((myP4[c] << 1) | (((myP4[c] & 0x08) ? 1 : 0) ^
-                  ((myP4[c] & 0x04) ? 1 : 0))) : 1;
-            }
-            break;
-          }
-
-          case 0x04:    // div 2
-          {
-            // Clock P4 toggling the lower bit (divide by 2) 
-            myP4[c] = (myP4[c] << 1) | ((myP4[c] & 0x01) ? 0 : 1);
-            break;
-          }
-
-          case 0x05:    // div 2
-          {
-            // Clock P4 toggling the lower bit (divide by 2) 
-            myP4[c] = (myP4[c] << 1) | ((myP4[c] & 0x01) ? 0 : 1);
-            break;
-          }
-
-          case 0x06:    // div 31 -> div 2
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // This does the divide-by 31 with length 13:18
-            if((myP5[c] & 0x0f) == 0x08)
-            {
-              // Clock P4 toggling the lower bit (divide by 2) 
-              myP4[c] = (myP4[c] << 1) | ((myP4[c] & 0x01) ? 0 : 1);
-            }
-            break;
-          }
-
-          case 0x07:    // 5 bit poly -> div 2
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // P5 clocks the 4 bit register
-            if(myP5[c] & 0x10)
-            {
-              // Clock P4 toggling the lower bit (divide by 2) 
-              myP4[c] = (myP4[c] << 1) | ((myP4[c] & 0x01) ? 0 : 1);
-            }
-            break;
-          }
-
-          case 0x08:    // 9 bit poly
-          {
-            // Clock P5 & P4 as a standard 9-bit LSFR taps at 8 & 4
-            myP5[c] = ((myP5[c] & 0x1f) || (myP4[c] & 0x0f)) ?
-              ((myP5[c] << 1) | (((myP4[c] & 0x08) ? 1 : 0) ^
-              ((myP5[c] & 0x10) ? 1 : 0))) : 1;
-            myP4[c] = (myP4[c] << 1) | ((myP5[c] & 0x20) ? 1 : 0);
-            break;
-          }
-
-          case 0x09:    // 5 bit poly
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // Clock value out of P5 into P4 with no modification
-            myP4[c] = (myP4[c] << 1) | ((myP5[c] & 0x20) ? 1 : 0);
-            break;
-          }
-
-          case 0x0a:    // div 31
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // This does the divide-by 31 with length 13:18
-            if((myP5[c] & 0x0f) == 0x08)
-            {
-              // Feed bit 4 of P5 into P4 (this will toggle back and forth)
-              myP4[c] = (myP4[c] << 1) | ((myP5[c] & 0x10) ? 1 : 0);
-            }
-            break;
-          }
-
-          case 0x0b:    // Set last 4 bits to 1
-          {
-            // A 1 is shifted into the 4-bit register each clock
-            myP4[c] = (myP4[c] << 1) | 0x01;
-            break;
-          }
-
-          case 0x0c:    // div 6
-          {
-            // Use 4-bit register to generate sequence 000111000111
-            myP4[c] = (~myP4[c] << 1) |
-                ((!(!(myP4[c] & 4) && ((myP4[c] & 7)))) ? 0 : 1);
-            break;
-          }
-
-          case 0x0d:    // div 6
-          {
-            // Use 4-bit register to generate sequence 000111000111
-            myP4[c] = (~myP4[c] << 1) |
-                ((!(!(myP4[c] & 4) && ((myP4[c] & 7)))) ? 0 : 1);
-            break;
-          }
-
-          case 0x0e:    // div 31 -> div 6
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // This does the divide-by 31 with length 13:18
-            if((myP5[c] & 0x0f) == 0x08)
-            {
-              // Use 4-bit register to generate sequence 000111000111
-              myP4[c] = (~myP4[c] << 1) |
-                  ((!(!(myP4[c] & 4) && ((myP4[c] & 7)))) ? 0 : 1);
-            }
-            break;
-          }
-
-          case 0x0f:    // poly 5 -> div 6
-          {
-            // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
-            myP5[c] = (myP5[c] & 0x1f) ?
-              ((myP5[c] << 1) | (((myP5[c] & 0x10) ? 1 : 0) ^
-              ((myP5[c] & 0x04) ? 1 : 0))) : 1;
-
-            // Use poly 5 to clock 4-bit div register
-            if(myP5[c] & 0x10)
-            {
-              // Use 4-bit register to generate sequence 000111000111
-              myP4[c] = (~myP4[c] << 1) |
-                  ((!(!(myP4[c] & 4) && ((myP4[c] & 7)))) ? 0 : 1);
-            }
-            break;
-          }
-        }
+        *(buffer++) = out0 + clip;
+        *(buffer++) = out1 + clip;
       }
+      else
+        *(buffer++) = out0 + out1 + clip;
+      outputCounter -= tiaFrequency;
+      samples--;
     }
+  }
+
+  myPolyState[0] = state0;
+  myPolyState[1] = state1;
+  myDivCounter[0] = counter0;
+  myDivCounter[1] = counter1;
+  myOutputCounter = outputCounter;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::processBandLimited(uInt8* buffer, uInt32 samples)
+{
+  Int32 v0 = ((myAUDV[0] << 2) * myVolumePercentage) / 100;
+  Int32 v1 = ((myAUDV[1] << 2) * myVolumePercentage) / 100;
+
+  // As in process(), except that the TIA clocks between divider pulses
+  // are skipped over, since the output can only change on a pulse.  The
+  // output counter is how far the next clock falls past the last sample
+  // passed, in units of 1/tiaFrequency of a sample.
+  const uInt16* poly0 = ourPolyTable[myAUDC[0]];
+  const uInt16* poly1 = ourPolyTable[myAUDC[1]];
+  uInt32 state0 = myPolyState[0], state1 = myPolyState[1];
+  uInt32 divide0 = myAUDF[0], divide1 = myAUDF[1];
+  uInt32 counter0 = myDivCounter[0], counter1 = myDivCounter[1];
+  Int32 out0 = ((state0 >> 3) & 0x01) * v0;
+  Int32 out1 = ((state1 >> 3) & 0x01) * v1;
+  uInt32 offset = myBlipOffset;
+  uInt32 outputCounter = myOutputCounter;
+  const uInt32 outputFrequency = myOutputFrequency;
+  const uInt32 tiaFrequency = myTIAFrequency;
+  const bool stereo = myChannels == 2;
+
+  // The volume may have been changed since the last call
+  addSteps(offset, outputCounter, out0, out1);
+
+  while(samples > 0)
+  {
+    uInt32 count = samples < (uInt32)BlipBuffer::ChunkSize ?
+                   samples : (uInt32)BlipBuffer::ChunkSize;
 
-    myOutputCounter += myOutputFrequency;
-  
-    if(myChannels == 1)
+    while(offset < count)
     {
-      // Handle mono sample generation
-      while((samples > 0) && (myOutputCounter >= myTIAFrequency))
+      // Skip to the clock where either divider next outputs a pulse,
+      // unless the samples wanted have all passed before that.  A silent
+      // channel can't change the output, so its pulses are only counted.
+      uInt32 clocks0 = v0 == 0 ? 0xffff :
+                       (counter0 >= divide0 ? 0 : divide0 - counter0);
+      uInt32 clocks1 = v1 == 0 ? 0xffff :
+                       (counter1 >= divide1 ? 0 : divide1 - counter1);
+      uInt32 clocks = clocks0 < clocks1 ? clocks0 : clocks1;
+      uInt32 left = (count - offset) * tiaFrequency - outputCounter;
+      bool done = false;
+
+      // Up to 0xffff clocks at the output rate overflows 32 bits above
+      // about 65 kHz, so that's worked out in 64 bits; once limited to
+      // what's left, it fits again
+      uInt64 span = (uInt64)clocks * outputFrequency;
+      if(span >= left)
+      {
+        clocks = (left + outputFrequency - 1) / outputFrequency;
+        span = (uInt64)clocks * outputFrequency;
+        done = true;
+      }
+
+      skipClocks(poly0, state0, counter0, divide0, clocks);
+      skipClocks(poly1, state1, counter1, divide1, clocks);
+      outputCounter += (uInt32)span;
+      while(outputCounter >= tiaFrequency)
+      {
+        outputCounter -= tiaFrequency;
+        ++offset;
+      }
+
+      if(done)
+        break;
+
+      // Now the clock with the pulse
+      if(++counter0 > divide0)
+      {
+        counter0 = 0;
+        state0 = poly0[state0];
+        out0 = ((state0 >> 3) & 0x01) * v0;
+      }
+      if(++counter1 > divide1)
       {
-        *(buffer++) = (((myP4[0] & 8) ? v0 : 0) + 
-            ((myP4[1] & 8) ? v1 : 0)) + myVolumeClip;
-        myOutputCounter -= myTIAFrequency;
-        samples--;
+        counter1 = 0;
+        state1 = poly1[state1];
+        out1 = ((state1 >> 3) & 0x01) * v1;
       }
+
+      // Its output applies to the samples from the next one on, so it's
+      // passed on before the counter moves
+      addSteps(offset, outputCounter, out0, out1);
+
+      outputCounter += outputFrequency;
+      while(outputCounter >= tiaFrequency)
+      {
+        outputCounter -= tiaFrequency;
+        ++offset;
+      }
+    }
+
+    if(stereo)
+    {
+      myBlip[0].readSamples(buffer, count, 2, myVolumeClip);
+      myBlip[1].readSamples(buffer + 1, count, 2, myVolumeClip);
     }
     else
+      myBlip[0].readSamples(buffer, count, 1, myVolumeClip);
+
+    buffer += count * myChannels;
+    samples -= count;
+    offset -= count;
+  }
+
+  myPolyState[0] = state0;
+  myPolyState[1] = state1;
+  myDivCounter[0] = counter0;
+  myDivCounter[1] = counter1;
+  myBlipOffset = offset;
+  myOutputCounter = outputCounter;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::skipClocks(const uInt16* poly, uInt32& state, uInt32& counter,
+                          uInt32 divide, uInt32 clocks)
+{
+  // The first pulse comes when the counter passes the divider, and then
+  // one every divide + 1 clocks
+  uInt32 first = counter >= divide ? 1 : divide - counter + 1;
+  if(clocks < first)
+  {
+    counter += clocks;
+    return;
+  }
+
+  clocks -= first;
+  state = poly[state];
+  for(uInt32 pulses = clocks / (divide + 1); pulses > 0; --pulses)
+    state = poly[state];
+  counter = clocks % (divide + 1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::addSteps(uInt32 offset, uInt32 outputCounter,
+                        Int32 out0, Int32 out1)
+{
+  Int32 delta0 = out0 - myBlipLevel[0];
+  Int32 delta1 = out1 - myBlipLevel[1];
+  if(delta0 == 0 && delta1 == 0)
+    return;
+
+  // The counter is below the TIA rate, but shifted it may not fit 32 bits
+  uInt32 fraction = (uInt32)(((uInt64)outputCounter << 16) / myTIAFrequency);
+  if(myChannels == 2)
+  {
+    if(delta0 != 0)
+      myBlip[0].addDelta(offset, fraction, delta0);
+    if(delta1 != 0)
+      myBlip[1].addDelta(offset, fraction, delta1);
+  }
+  else
+    myBlip[0].addDelta(offset, fraction, delta0 + delta1);
+
+  myBlipLevel[0] = out0;
+  myBlipLevel[1] = out1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::clockPolys(uInt8 mode, uInt8& p4, uInt8& p5)
+{
+  switch(mode)
+  {
+    case 0x00:    // Set to 1
+    {
+      // Shift a 1 into the 4-bit register each clock
+      p4 = (p4 << 1) | 0x01;
+      break;
+    }
+
+    case 0x01:    // 4 bit poly
+    {
+      // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
+      p4 = (p4 & 0x0f) ? 
+          ((p4 << 1) | (((p4 & 0x08) ? 1 : 0) ^
+          ((p4 & 0x04) ? 1 : 0))) : 1;
+      break;
+    }
+
+    case 0x02:    // div 31 -> 4 bit poly
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // This does the divide-by 31 with length 13:18
+      if((p5 & 0x0f) == 0x08)
+      {
+        // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
+        p4 = (p4 & 0x0f) ? 
+            ((p4 << 1) | (((p4 & 0x08) ? 1 : 0) ^
+            ((p4 & 0x04) ? 1 : 0))) : 1;
+      }
+      break;
+    }
+
+    case 0x03:    // 5 bit poly -> 4 bit poly
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // P5 clocks the 4 bit poly
+      if(p5 & 0x10)
+      {
+        // Clock P4 as a standard 4-bit LSFR taps at bits 3 & 2
+        p4 = (p4 & 0x0f) ? 
+            ((p4 << 1) | (((p4 & 0x08) ? 1 : 0) ^
+            ((p4 & 0x04) ? 1 : 0))) : 1;
+      }
+      break;
+    }
+
+    case 0x04:    // div 2
+    {
+      // Clock P4 toggling the lower bit (divide by 2) 
+      p4 = (p4 << 1) | ((p4 & 0x01) ? 0 : 1);
+      break;
+    }
+
+    case 0x05:    // div 2
+    {
+      // Clock P4 toggling the lower bit (divide by 2) 
+      p4 = (p4 << 1) | ((p4 & 0x01) ? 0 : 1);
+      break;
+    }
+
+    case 0x06:    // div 31 -> div 2
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // This does the divide-by 31 with length 13:18
+      if((p5 & 0x0f) == 0x08)
+      {
+        // Clock P4 toggling the lower bit (divide by 2) 
+        p4 = (p4 << 1) | ((p4 & 0x01) ? 0 : 1);
+      }
+      break;
+    }
+
+    case 0x07:    // 5 bit poly -> div 2
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // P5 clocks the 4 bit register
+      if(p5 & 0x10)
+      {
+        // Clock P4 toggling the lower bit (divide by 2) 
+        p4 = (p4 << 1) | ((p4 & 0x01) ? 0 : 1);
+      }
+      break;
+    }
+
+    case 0x08:    // 9 bit poly
+    {
+      // Clock P5 & P4 as a standard 9-bit LSFR taps at 8 & 4
+      p5 = ((p5 & 0x1f) || (p4 & 0x0f)) ?
+        ((p5 << 1) | (((p4 & 0x08) ? 1 : 0) ^
+        ((p5 & 0x10) ? 1 : 0))) : 1;
+      p4 = (p4 << 1) | ((p5 & 0x20) ? 1 : 0);
+      break;
+    }
+
+    case 0x09:    // 5 bit poly
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // Clock value out of P5 into P4 with no modification
+      p4 = (p4 << 1) | ((p5 & 0x20) ? 1 : 0);
+      break;
+    }
+
+    case 0x0a:    // div 31
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // This does the divide-by 31 with length 13:18
+      if((p5 & 0x0f) == 0x08)
+      {
+        // Feed bit 4 of P5 into P4 (this will toggle back and forth)
+        p4 = (p4 << 1) | ((p5 & 0x10) ? 1 : 0);
+      }
+      break;
+    }
+
+    case 0x0b:    // Set last 4 bits to 1
+    {
+      // A 1 is shifted into the 4-bit register each clock
+      p4 = (p4 << 1) | 0x01;
+      break;
+    }
+
+    case 0x0c:    // div 6
+    {
+      // Use 4-bit register to generate sequence 000111000111
+      p4 = (~p4 << 1) |
+          ((!(!(p4 & 4) && ((p4 & 7)))) ? 0 : 1);
+      break;
+    }
+
+    case 0x0d:    // div 6
+    {
+      // Use 4-bit register to generate sequence 000111000111
+      p4 = (~p4 << 1) |
+          ((!(!(p4 & 4) && ((p4 & 7)))) ? 0 : 1);
+      break;
+    }
+
+    case 0x0e:    // div 31 -> div 6
+    {
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // This does the divide-by 31 with length 13:18
+      if((p5 & 0x0f) == 0x08)
+      {
+        // Use 4-bit register to generate sequence 000111000111
+        p4 = (~p4 << 1) |
+            ((!(!(p4 & 4) && ((p4 & 7)))) ? 0 : 1);
+      }
+      break;
+    }
+
+    case 0x0f:    // poly 5 -> div 6
     {
-      // Handle stereo sample generation
-      while((samples > 0) && (myOutputCounter >= myTIAFrequency))
+      // Clock P5 as a standard 5-bit LSFR taps at bits 4 & 2
+      p5 = (p5 & 0x1f) ?
+        ((p5 << 1) | (((p5 & 0x10) ? 1 : 0) ^
+        ((p5 & 0x04) ? 1 : 0))) : 1;
+
+      // Use poly 5 to clock 4-bit div register
+      if(p5 & 0x10)
       {
-        *(buffer++) = ((myP4[0] & 8) ? v0 : 0) + myVolumeClip;
-        *(buffer++) = ((myP4[1] & 8) ? v1 : 0) + myVolumeClip;
-        myOutputCounter -= myTIAFrequency;
-        samples--;
+        // Use 4-bit register to generate sequence 000111000111
+        p4 = (~p4 << 1) |
+            ((!(!(p4 & 4) && ((p4 & 7)))) ? 0 : 1);
       }
+      break;
     }
   }
 }
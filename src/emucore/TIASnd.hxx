@@ -20,11 +20,23 @@
 #define TIASOUND_HXX
 
 #include "bspf.hxx"
+#include "BlipBuffer.hxx"
 
 /**
   This class implements a fairly accurate emulation of the TIA sound
   hardware.
 
+  Each channel's 4-bit and 5-bit polynomial counters (which together
+  form the 9-bit one) are kept as a single 9-bit state.  How that state
+  is clocked depends on the AUDC mode, so the next state for every mode
+  and state is worked out once, and generating samples is only a table
+  lookup per divider pulse.
+
+  When samples are wanted at a different rate than the TIA's, the
+  changes of each channel's output are fed to a blip buffer at the exact
+  time they happen, which makes band-limited samples at the output rate
+  instead of picking the nearest TIA sample (which aliases).
+
   @author  Bradford W. Mott
   @version $Id: TIASnd.hxx,v 1.8 2009-01-01 18:13:37 stephena Exp $
 */
@@ -99,47 +111,56 @@ class TIASound
     */
     void volume(uInt32 percent);
 
+    /**
+      Fill in the table of next poly states for every AUDC mode.  This is
+      done once, during program startup, so it doesn't need to be called
+      from anywhere else.
+    */
+    static void buildTables();
+
   private:
     /**
-      Frequency divider class which outputs 1 after "divide-by" clocks. This
-      is used to divide the main frequency by the values 1 to 32.
-    */
-    class FreqDiv
-    {
-      public:
-        FreqDiv()
-        {
-          myDivideByValue = myCounter = 0;
-        }
-
-        void set(uInt32 divideBy)
-        {
-          myDivideByValue = divideBy;
-        }
-
-        bool clock()
-        {
-          if(++myCounter > myDivideByValue)
-          {
-            myCounter = 0;
-            return true;
-          }
-          return false;
-        }
-
-      private:
-        uInt32 myDivideByValue;
-        uInt32 myCounter;
-    };
+      Create samples through the blip buffers, when the output frequency
+      isn't the TIA frequency.
+    */
+    void processBandLimited(uInt8* buffer, uInt32 samples);
+
+    /**
+      Set up the blip buffers for the current frequencies and channels.
+    */
+    void resetBandLimited();
+
+    /**
+      Clock a channel's divider the given number of times, along with
+      its polys whenever it outputs a pulse.
+    */
+    static void skipClocks(const uInt16* poly, uInt32& state, uInt32& counter,
+                           uInt32 divide, uInt32 clocks);
+
+    /**
+      Tell the blip buffers about any change of the channels' outputs,
+      happening just before the given sample.
+
+      @param offset         The sample the change comes before
+      @param outputCounter  How far past the sample before that one the
+                            change happens, in 1/tiaFrequency of a sample
+      @param out0           The new output of channel 0
+      @param out1           The new output of channel 1
+    */
+    void addSteps(uInt32 offset, uInt32 outputCounter, Int32 out0, Int32 out1);
+
+    /**
+      Clock the 4-bit and 5-bit polys once, as the given AUDC mode does.
+    */
+    static void clockPolys(uInt8 mode, uInt8& p4, uInt8& p5);
 
   private:
     uInt8 myAUDC[2];
     uInt8 myAUDF[2];
     uInt8 myAUDV[2];
 
-    FreqDiv myFreqDiv[2];    // Frequency dividers
-    uInt8 myP4[2];           // 4-bit register LFSR (lower 4 bits used)
-    uInt8 myP5[2];           // 5-bit register LFSR (lower 5 bits used)
+    uInt8 myDivCounter[2];   // Frequency dividers (pulse every AUDF+1 clocks)
+    uInt16 myPolyState[2];   // 5-bit LFSR in bits 8-4, 4-bit LFSR in bits 3-0
 
     Int32  myOutputFrequency;
     Int32  myTIAFrequency;
@@ -147,6 +168,16 @@ class TIASound
     Int32  myOutputCounter;
     uInt32 myVolumePercentage;
     uInt8  myVolumeClip;
+
+    // Used when resampling: a blip buffer for each channel (only the first
+    // in mono), the output of each channel they were last told about, and
+    // the number of samples already passed which haven't been read yet
+    BlipBuffer myBlip[2];
+    Int32  myBlipLevel[2];
+    uInt32 myBlipOffset;
+
+    // The next poly state, for each AUDC mode and current state
+    static uInt16 ourPolyTable[16][512];
 };
 
 #endif
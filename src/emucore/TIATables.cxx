@@ -16,8 +16,6 @@
 // $Id: TIATables.cxx,v 1.3 2009-02-08 21:07:06 stephena Exp $
 //============================================================================
 
-#include <cassert>
-
 #include "bspf.hxx"
 #include "TIATables.hxx"
 
@@ -335,130 +333,37 @@ void TIATables::computePlayerMaskTable()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIATables::computePlayerPositionResetWhenTable()
 {
-  uInt32 mode, oldx, newx;
-
-  // Loop through all player modes, all old player positions, and all new
-  // player positions and determine where the new position is located:
+  // Where each copy of the player starts (relative to the player position)
+  // and how wide it is, for all player modes
+  static const Int32 copies[8][3] = {
+    { 0, -1, -1 }, { 0, 16, -1 }, { 0, 32, -1 }, { 0, 16, 32 },
+    { 0, 64, -1 }, { 0, -1, -1 }, { 0, 32, 64 }, { 0, -1, -1 }
+  };
+  static const Int32 width[8] = { 8, 8, 8, 8, 8, 16, 8, 32 };
+
+  // Loop through all player modes and all new player positions relative
+  // to the old one and determine where the new position is located:
   // 1 means the new position is within the display of an old copy of the
   // player, -1 means the new position is within the delay portion of an
   // old copy of the player, and 0 means it's neither of these two
-  for(mode = 0; mode < 8; ++mode)
+  for(uInt32 mode = 0; mode < 8; ++mode)
   {
-    for(oldx = 0; oldx < 160; ++oldx)
-    {
-      // Set everything to 0 for non-delay/non-display section
-      for(newx = 0; newx < 160; ++newx)
-      {
-        PlayerPositionResetWhenTable[mode][oldx][newx] = 0;
-      }
-
-      // Now, we'll set the entries for non-delay/non-display section
-      for(newx = 0; newx < 160 + 72 + 5; ++newx)
-      {
-        if(mode == 0x00)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+    Int32 x;
 
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x01)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 16)) && (newx < (oldx + 16 + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 16 + 4) && (newx < (oldx + 16 + 4 + 8)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x02)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 32)) && (newx < (oldx + 32 + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 32 + 4) && (newx < (oldx + 32 + 4 + 8)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x03)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 16)) && (newx < (oldx + 16 + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 32)) && (newx < (oldx + 32 + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 16 + 4) && (newx < (oldx + 16 + 4 + 8)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 32 + 4) && (newx < (oldx + 32 + 4 + 8)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x04)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 64)) && (newx < (oldx + 64 + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 64 + 4) && (newx < (oldx + 64 + 4 + 8)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x05)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+    // Set everything to 0 for non-delay/non-display section
+    for(x = 0; x < 160; ++x)
+      PlayerPositionResetWhenTable[mode][x] = 0;
 
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 16)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x06)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 32)) && (newx < (oldx + 32 + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 64)) && (newx < (oldx + 64 + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 32 + 4) && (newx < (oldx + 32 + 4 + 8)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 64 + 4) && (newx < (oldx + 64 + 4 + 8)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x07)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+    // Now, we'll set the entries for the delay and display sections
+    for(uInt32 copy = 0; copy < 3 && copies[mode][copy] >= 0; ++copy)
+    {
+      Int32 start = copies[mode][copy];
 
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 32)))
-            PlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-      }
+      for(x = start; x < start + 4; ++x)
+        PlayerPositionResetWhenTable[mode][x] = -1;
 
-      // Let's do a sanity check on  table entries
-      uInt32 s1 = 0, s2 = 0;
-      for(newx = 0; newx < 160; ++newx)
-      {
-        if(PlayerPositionResetWhenTable[mode][oldx][newx] == -1)
-          ++s1;
-        if(PlayerPositionResetWhenTable[mode][oldx][newx] == 1)
-          ++s2;
-      }
-      assert((s1 % 4 == 0) && (s2 % 8 == 0));
+      for(x = start + 4; x < start + 4 + width[mode]; ++x)
+        PlayerPositionResetWhenTable[mode][x] = 1;
     }
   }
 }
@@ -635,10 +540,18 @@ const Int32 TIATables::CompleteMotionTable[76][16] = {
 uInt8 TIATables::PlayerMaskTable[4][2][8][320];
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Int8 TIATables::PlayerPositionResetWhenTable[8][160][160];
+Int8 TIATables::PlayerPositionResetWhenTable[8][160];
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 TIATables::PlayerReflectTable[256];
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 TIATables::PlayfieldTable[2][160];
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The tables only depend on constants, so compute them while the program is
+// starting up (and still single-threaded) instead of in every TIA constructor
+static struct TIATablesInitializer
+{
+  TIATablesInitializer() { TIATables::computeAllTables(); }
+} ourTIATablesInitializer;
@@ -108,7 +108,9 @@ class TIATables
 {
   public:
     /**
-      Compute all static tables used by the TIA
+      Compute all static tables used by the TIA.  This is done once, during
+      program startup, so that the tables are never written to while any
+      TIA (in any thread) is using them.
     */
     static void computeAllTables();
 
@@ -137,8 +139,10 @@ class TIATables
     // Player mask table
     static uInt8 PlayerMaskTable[4][2][8][320];
 
-    // Indicates if player is being reset during delay, display or other times
-    static Int8 PlayerPositionResetWhenTable[8][160][160];
+    // Indicates if player is being reset during delay, display or other
+    // times, indexed by the player mode and the new player position
+    // relative to the old one ((new - old + 160) % 160)
+    static Int8 PlayerPositionResetWhenTable[8][160];
 
     // Used to reflect a players graphics
     static uInt8 PlayerReflectTable[256];
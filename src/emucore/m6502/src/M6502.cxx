@@ -20,6 +20,8 @@
 
 #ifdef DEBUGGER_SUPPORT
   #include "Expression.hxx"
+  #include "CompiledExpression.hxx"
+  #include "PackedBitArray.hxx"
 #endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -35,6 +37,13 @@ M6502::M6502(uInt32 systemCyclesPerProcessorCycle)
   myBreakPoints = NULL;
   myReadTraps   = NULL;
   myWriteTraps  = NULL;
+  myInstrumented = false;
+  myCondBreakRAM[0] = myCondBreakRAM[1] = myCondBreakRAM[2] = myCondBreakRAM[3] = 0;
+  myCondBreakRAMWritten = false;
+  myCondBreakInvalid = true;
+  myCondBreakRegs = 0;
+  myCondBreakPC = 0;
+  myCondBreakPS = 0;
 #endif
 
   // Compute the System Cycle table
@@ -49,8 +58,12 @@ M6502::M6502(uInt32 systemCyclesPerProcessorCycle)
 M6502::~M6502()
 {
 #ifdef DEBUGGER_SUPPORT
+  for(uInt32 i = 0; i < myCompiledBreakConds.size(); i++)
+    delete myCompiledBreakConds[i];
+
   myBreakConds.clear();
   myBreakCondNames.clear();
+  myCompiledBreakConds.clear();
 #endif
 }
 
@@ -433,6 +446,9 @@ unsigned int M6502::addCondBreak(Expression *e, const string& name)
 {
   myBreakConds.push_back(e);
   myBreakCondNames.push_back(name);
+  myCompiledBreakConds.push_back(new CompiledExpression());
+  myCondBreakInvalid = true;
+  updateInstrumentation();
   return myBreakConds.size() - 1;
 }
 
@@ -442,19 +458,27 @@ void M6502::delCondBreak(unsigned int brk)
   if(brk < myBreakConds.size())
   {
     delete myBreakConds[brk];
+    delete myCompiledBreakConds[brk];
     myBreakConds.remove_at(brk);
     myBreakCondNames.remove_at(brk);
+    myCompiledBreakConds.remove_at(brk);
   }
+  updateInstrumentation();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::clearCondBreaks()
 {
   for(uInt32 i = 0; i < myBreakConds.size(); i++)
+  {
     delete myBreakConds[i];
+    delete myCompiledBreakConds[i];
+  }
 
   myBreakConds.clear();
   myBreakCondNames.clear();
+  myCompiledBreakConds.clear();
+  updateInstrumentation();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -466,17 +490,67 @@ const StringList& M6502::getCondBreakNames() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int M6502::evalCondBreaks()
 {
-  for(uInt32 i = 0; i < myBreakConds.size(); i++)
-    if(myBreakConds[i]->evaluate())
+  if(myCompiledBreakConds.size() == 0)
+    return -1;
+
+  if(myCondBreakInvalid)
+    prepareCondBreaks();
+
+  // Find out which of the values the conditions may read have changed
+  // since they were last evaluated
+  uInt32 regs = A | (X << 8) | (Y << 16) | (SP << 24);
+  uInt32 diff = regs ^ myCondBreakRegs;
+  uInt8 ps = PS();
+
+  uInt32 changed = CompiledExpression::DepAlways;
+  if(diff & 0x000000ff) changed |= CompiledExpression::DepA;
+  if(diff & 0x0000ff00) changed |= CompiledExpression::DepX;
+  if(diff & 0x00ff0000) changed |= CompiledExpression::DepY;
+  if(diff & 0xff000000) changed |= CompiledExpression::DepSP;
+  if(PC != myCondBreakPC) changed |= CompiledExpression::DepPC;
+  if(ps != myCondBreakPS) changed |= CompiledExpression::DepPS;
+  if(myCondBreakRAMWritten) changed |= CompiledExpression::DepRAM;
+  if(myCondBreakInvalid)    changed = ~0;
+
+  myCondBreakRegs = regs;
+  myCondBreakPC = PC;
+  myCondBreakPS = ps;
+  myCondBreakRAMWritten = false;
+  myCondBreakInvalid = false;
+
+  for(uInt32 i = 0; i < myCompiledBreakConds.size(); i++)
+  {
+    CompiledExpression* cond = myCompiledBreakConds[i];
+    if(cond->dependencies() & changed)
+      cond->evaluate();
+    if(cond->result())
       return i;
+  }
 
   return -1; // no break hit
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502::prepareCondBreaks()
+{
+  myCondBreakRAM[0] = myCondBreakRAM[1] = myCondBreakRAM[2] = myCondBreakRAM[3] = 0;
+
+  for(uInt32 i = 0; i < myBreakConds.size(); i++)
+  {
+    CompiledExpression* cond = myCompiledBreakConds[i];
+    cond->compile(myBreakConds[i], *myDebugger);
+
+    const uInt32* ram = cond->ramMask();
+    for(int j = 0; j < 4; ++j)
+      myCondBreakRAM[j] |= ram[j];
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::setBreakPoints(PackedBitArray *bp)
 {
   myBreakPoints = bp;
+  updateInstrumentation();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -484,6 +558,18 @@ void M6502::setTraps(PackedBitArray *read, PackedBitArray *write)
 {
   myReadTraps = read;
   myWriteTraps = write;
+  updateInstrumentation();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502::updateInstrumentation()
+{
+  // The debugger keeps its arrays installed after the last entry is
+  // removed, so only count arrays which actually have something set
+  myInstrumented = (myBreakPoints != NULL && !myBreakPoints->isEmpty()) ||
+                   (myReadTraps != NULL && !myReadTraps->isEmpty()) ||
+                   (myWriteTraps != NULL && !myWriteTraps->isEmpty()) ||
+                   myBreakConds.size() > 0;
 }
 
 #endif
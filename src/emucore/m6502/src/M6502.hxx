@@ -26,6 +26,7 @@ class Deserializer;
 class Debugger;
 class CpuDebug;
 class Expression;
+class CompiledExpression;
 class PackedBitArray;
 
 #include "bspf.hxx"
@@ -34,6 +35,7 @@ class PackedBitArray;
 #include "StringList.hxx"
 
 typedef Common::Array<Expression*> ExpressionList;
+typedef Common::Array<CompiledExpression*> CompiledExpressionList;
 
 /**
   This is an abstract base class for classes that emulate the
@@ -93,6 +95,17 @@ class M6502
     */
     virtual void install(System& system);
 
+    /**
+      Notification method invoked by the system when the access methods
+      for a page are changed (for example, when a cartridge switches
+      banks).  Processors which keep their own view of the address space
+      should update it here.
+
+      @param page    The page whose access methods were changed
+      @param access  The new access methods for the page
+    */
+    virtual void pageAccessChanged(uInt16 page, const System::PageAccess& access) { }
+
     /**
       Reset the processor to its power-on state.  This method should not 
       be invoked until the entire 6502 system is constructed and installed
@@ -229,6 +242,40 @@ class M6502
     void clearCondBreaks();
     const StringList& getCondBreakNames() const;
     int evalCondBreaks();
+
+  protected:
+    /**
+      Mark the conditional breaks as needing to be recompiled and
+      re-evaluated.  Called whenever execution resumes, since equates,
+      functions and memory may have been changed in the debugger.
+    */
+    void invalidateCondBreaks() { myCondBreakInvalid = true; }
+
+    /**
+      Note a write to the given address, so that conditional breaks
+      reading that RAM location are re-evaluated.
+
+      @param address The address being written
+    */
+    void condBreakWrite(uInt16 address)
+    {
+      if((address & 0x1280) == 0x0080 &&
+         (myCondBreakRAM[(address >> 5) & 0x03] & (1 << (address & 0x1f))))
+        myCondBreakRAMWritten = true;
+    }
+
+  private:
+    /**
+      Recompute myInstrumented after a breakpoint, trap or condition
+      has been armed or cleared.
+    */
+    void updateInstrumentation();
+
+    /**
+      Compile the conditional breaks, and collect the RAM locations
+      they read.
+    */
+    void prepareCondBreaks();
 #endif
 
   protected:
@@ -313,6 +360,20 @@ class M6502
 
     StringList myBreakCondNames;
     ExpressionList myBreakConds;
+
+    // Compiled form of myBreakConds, and the state they were last
+    // evaluated in, used to skip conditions whose inputs haven't changed
+    CompiledExpressionList myCompiledBreakConds;
+    uInt32 myCondBreakRAM[4];
+    bool myCondBreakRAMWritten;
+    bool myCondBreakInvalid;
+    uInt32 myCondBreakRegs;
+    uInt16 myCondBreakPC;
+    uInt8 myCondBreakPS;
+
+    // Is any breakpoint, trap or condition armed?  If not, processors
+    // can run without checking for them on every instruction and access
+    bool myInstrumented;
 #endif
 
   protected:
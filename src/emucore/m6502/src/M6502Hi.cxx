@@ -32,6 +32,8 @@ M6502High::M6502High(uInt32 systemCyclesPerProcessorCycle)
 {
   myNumberOfDistinctAccesses = 0;
   myLastAddress = 0;
+  myPageTable = 0;
+  myPageShift = myPageMask = myNumberOfPages = 0;
 
 #ifdef DEBUGGER_SUPPORT
   myJustHitTrapFlag = false;
@@ -41,9 +43,39 @@ M6502High::M6502High(uInt32 systemCyclesPerProcessorCycle)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 M6502High::~M6502High()
 {
+  delete[] myPageTable;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502High::install(System& system)
+{
+  M6502::install(system);
+
+  myPageShift = system.pageShift();
+  myPageMask = system.pageMask();
+  myNumberOfPages = system.numberOfPages();
+
+  // Pick up any pages which were mapped before the processor was attached
+  delete[] myPageTable;
+  myPageTable = new PageInfo[myNumberOfPages];
+  for(uInt16 page = 0; page < myNumberOfPages; ++page)
+    pageAccessChanged(page, system.getPageAccess(page));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502High::pageAccessChanged(uInt16 page, const System::PageAccess& access)
+{
+  if(myPageTable != 0 && page < myNumberOfPages)
+  {
+    PageInfo& info = myPageTable[page];
+    info.peekBase = access.directPeekBase;
+    info.pokeBase = access.directPokeBase;
+    info.device = access.device;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class Instrumentation>
 inline uInt8 M6502High::peek(uInt16 address)
 {
   if(address != myLastAddress)
@@ -54,7 +86,8 @@ inline uInt8 M6502High::peek(uInt16 address)
   mySystem->incrementCycles(mySystemCyclesPerProcessorCycle);
 
 #ifdef DEBUGGER_SUPPORT
-  if(myReadTraps != NULL && myReadTraps->isSet(address))
+  if(Instrumentation::Enabled &&
+     myReadTraps != NULL && myReadTraps->isSet(address))
   {
     myJustHitTrapFlag = true;
     myHitTrapInfo.message = "RTrap: ";
@@ -62,12 +95,24 @@ inline uInt8 M6502High::peek(uInt16 address)
   }
 #endif
 
-  uInt8 result = mySystem->peek(address);
+  // RAM and ROM are read inline; only hotspot pages call the device
+  uInt16 page = (address >> myPageShift) & (myNumberOfPages - 1);
+  const PageInfo& info = myPageTable[page];
+  uInt8 result;
+  if(info.peekBase != 0)
+    result = info.peekBase[address & myPageMask];
+  else
+  {
+    mySystem->counters().devicePeek(page);
+    result = info.device->peek(address);
+  }
+  mySystem->setDataBusState(result);
   myLastAccessWasRead = true;
   return result;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class Instrumentation>
 inline void M6502High::poke(uInt16 address, uInt8 value)
 {
   if(address != myLastAddress)
@@ -78,24 +123,51 @@ inline void M6502High::poke(uInt16 address, uInt8 value)
   mySystem->incrementCycles(mySystemCyclesPerProcessorCycle);
 
 #ifdef DEBUGGER_SUPPORT
-  if(myWriteTraps != NULL && myWriteTraps->isSet(address))
+  if(Instrumentation::Enabled)
   {
-    myJustHitTrapFlag = true;
-    myHitTrapInfo.message = "WTrap: ";
-    myHitTrapInfo.address = address;
+    if(myWriteTraps != NULL && myWriteTraps->isSet(address))
+    {
+      myJustHitTrapFlag = true;
+      myHitTrapInfo.message = "WTrap: ";
+      myHitTrapInfo.address = address;
+    }
+    condBreakWrite(address);
   }
 #endif
 
-  mySystem->poke(address, value);
+  const PageInfo& info = myPageTable[(address >> myPageShift) & (myNumberOfPages - 1)];
+  if(info.pokeBase != 0)
+    info.pokeBase[address & myPageMask] = value;
+  else
+    info.device->poke(address, value);
+  mySystem->setDataBusState(value);
   myLastAccessWasRead = false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool M6502High::execute(uInt32 number)
+{
+#ifdef DEBUGGER_SUPPORT
+  // Only pay for the debugger's checks while something is armed
+  if(myInstrumented || myJustHitTrapFlag)
+    return run<Instrumented>(number);
+#endif
+
+  return run<Uninstrumented>(number);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class Instrumentation>
+bool M6502High::run(uInt32 number)
 {
   // Clear all of the execution status bits except for the fatal error bit
   myExecutionStatus &= FatalErrorBit;
 
+#ifdef DEBUGGER_SUPPORT
+  if(Instrumentation::Enabled)
+    invalidateCondBreaks();
+#endif
+
   // Loop until execution is stopped or a fatal error occurs
   for(;;)
   {
@@ -105,30 +177,33 @@ bool M6502High::execute(uInt32 number)
       uInt8 operand = 0;
 
 #ifdef DEBUGGER_SUPPORT
-      if(myJustHitTrapFlag)
+      if(Instrumentation::Enabled)
       {
-        if(myDebugger->start(myHitTrapInfo.message, myHitTrapInfo.address))
+        if(myJustHitTrapFlag)
         {
-          myJustHitTrapFlag = false;
-          return true;
+          if(myDebugger->start(myHitTrapInfo.message, myHitTrapInfo.address))
+          {
+            myJustHitTrapFlag = false;
+            return true;
+          }
         }
-      }
 
-      if(myBreakPoints != NULL)
-      {
-        if(myBreakPoints->isSet(PC))
+        if(myBreakPoints != NULL)
         {
-          if(myDebugger->start("BP: ", PC))
-            return true;
+          if(myBreakPoints->isSet(PC))
+          {
+            if(myDebugger->start("BP: ", PC))
+              return true;
+          }
         }
-      }
 
-      int cond = evalCondBreaks();
-      if(cond > -1)
-      {
-        string buf = "CBP: " + myBreakCondNames[cond];
-        if(myDebugger->start(buf))
-          return true;
+        int cond = evalCondBreaks();
+        if(cond > -1)
+        {
+          string buf = "CBP: " + myBreakCondNames[cond];
+          if(myDebugger->start(buf))
+            return true;
+        }
       }
 #endif
 
@@ -137,7 +212,7 @@ bool M6502High::execute(uInt32 number)
 #endif
 
       // Fetch instruction at the program counter
-      IR = peek(PC++);
+      IR = peek<Instrumentation>(PC++);
 
 #ifdef DEBUG
       debugStream << "IR=" << hex << setw(2) << (int)IR << " ";
@@ -147,8 +222,13 @@ bool M6502High::execute(uInt32 number)
       // Call code to execute the instruction
       switch(IR)
       {
-        // 6502 instruction emulation is generated by an M4 macro file
+        // 6502 instruction emulation is generated by an M4 macro file;
+        // its memory accesses are made through the instrumentation policy
+        #define peek(address) peek<Instrumentation>(address)
+        #define poke(address, value) poke<Instrumentation>(address, value)
         #include "M6502Hi.ins"
+        #undef peek
+        #undef poke
 
         default:
           // Oops, illegal instruction executed so set fatal error flag
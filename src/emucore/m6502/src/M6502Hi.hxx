@@ -54,6 +54,24 @@ class M6502High : public M6502
     virtual ~M6502High();
 
   public:
+    /**
+      Install the processor in the specified system.  Invoked by the
+      system when the processor is attached to it.
+
+      @param system The system the processor should install itself in
+    */
+    virtual void install(System& system);
+
+    /**
+      Notification method invoked by the system when the access methods
+      for a page are changed.  The processor's copy of the page's
+      direct access pointers is updated.
+
+      @param page    The page whose access methods were changed
+      @param access  The new access methods for the page
+    */
+    virtual void pageAccessChanged(uInt16 page, const System::PageAccess& access);
+
     /**
       Execute instructions until the specified number of instructions
       is executed, someone stops execution, or an error occurs.  Answers
@@ -107,11 +125,13 @@ class M6502High : public M6502
   protected:
     /*
       Get the byte at the specified address and update the cycle
-      count
+      count.  Bytes on directly accessed pages are read inline; only
+      the remaining pages (TIA, RIOT I/O, bankswitch hotspots) call
+      the device.
 
       @return The byte at the specified address
     */
-    inline uInt8 peek(uInt16 address);
+    template<class Instrumentation> inline uInt8 peek(uInt16 address);
 
     /**
       Change the byte at the specified address to the given value and
@@ -120,7 +140,21 @@ class M6502High : public M6502
       @param address The address where the value should be stored
       @param value The value to be stored at the address
     */
-    inline void poke(uInt16 address, uInt8 value);
+    template<class Instrumentation> inline void poke(uInt16 address, uInt8 value);
+
+  private:
+    /**
+      Instrumentation policies for the execute loop and memory accesses.
+      Breakpoints, traps and conditions are only checked when the policy
+      is enabled, so the lean variant pays nothing for the debugger.
+    */
+    struct Instrumented { enum { Enabled = 1 }; };
+    struct Uninstrumented { enum { Enabled = 0 }; };
+
+    /**
+      The body of execute(), specialized for the given policy.
+    */
+    template<class Instrumentation> bool run(uInt32 number);
 
   private:
     // Indicates the numer of distinct memory accesses
@@ -128,6 +162,21 @@ class M6502High : public M6502
 
     // Indicates the last address which was accessed
     uInt16 myLastAddress;
+
+    // The processor's copy of the system's page access table, so that
+    // memory can be accessed without going through System::peek/poke
+    struct PageInfo
+    {
+      uInt8* peekBase;   // Direct peek base, or 0 to call the device
+      uInt8* pokeBase;   // Direct poke base, or 0 to call the device
+      Device* device;    // Device handling the page's other accesses
+    };
+    PageInfo* myPageTable;
+
+    // Information from the system used to find an address's page
+    uInt16 myPageShift;
+    uInt16 myPageMask;
+    uInt16 myNumberOfPages;
 };
 #endif
 
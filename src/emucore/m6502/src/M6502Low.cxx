@@ -67,6 +67,7 @@ inline void M6502Low::poke(uInt16 address, uInt8 value)
     myHitTrapInfo.message = "WTrap: ";
     myHitTrapInfo.address = address;
   }
+  condBreakWrite(address);
 #endif
 
   mySystem->poke(address, value);
@@ -79,6 +80,10 @@ bool M6502Low::execute(uInt32 number)
   // Clear all of the execution status bits except for the fatal error bit
   myExecutionStatus &= FatalErrorBit;
 
+#ifdef DEBUGGER_SUPPORT
+  invalidateCondBreaks();
+#endif
+
   // Loop until execution is stopped or a fatal error occurs
   for(;;)
   {
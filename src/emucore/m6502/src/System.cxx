@@ -35,6 +35,7 @@ System::System(uInt16 n, uInt16 m)
     myM6502(0),
     myTIA(0),
     myCycles(0),
+    myCounters(1 << (n - m), m),
     myDataBusState(0),
     myDataBusLocked(false)
 {
@@ -141,7 +142,8 @@ void System::resetCycles()
     myDevices[i]->systemCyclesReset();
   }
 
-  // Now, we reset cycle count to zero
+  // Now, we reset cycle count to zero (keeping the count for the counters)
+  myCounters.addCycles(myCycles);
   myCycles = 0;
 }
 
@@ -155,6 +157,10 @@ void System::setPageAccess(uInt16 page, const PageAccess& access)
   assert(access.device != 0);
 
   myPageAccessTable[page] = access;
+
+  // Let the processor know, so it can update its view of this page
+  if(myM6502 != 0)
+    myM6502->pageAccessChanged(page, access);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -171,7 +177,8 @@ System::System(const System& s)
   : myAddressMask(s.myAddressMask),
     myPageShift(s.myPageShift),
     myPageMask(s.myPageMask),
-    myNumberOfPages(s.myNumberOfPages)
+    myNumberOfPages(s.myNumberOfPages),
+    myCounters(s.myNumberOfPages, s.myPageShift)
 {
   assert(false);
 }
@@ -198,6 +205,7 @@ uInt8 System::peek(uInt16 addr)
   }
   else
   {
+    myCounters.devicePeek((addr & myAddressMask) >> myPageShift);
     result = access.device->peek(addr);
   }
 
@@ -282,7 +290,10 @@ bool System::load(Deserializer& in)
     if(in.getString() != device)
       return false;
 
+    // The counters carry on from the cycles before the load
+    uInt32 cycles = myCycles;
     myCycles = (uInt32) in.getInt();
+    myCounters.addCycles(cycles - myCycles);
 
     // Next, load state for the CPU
     if(!myM6502->load(in))
@@ -28,6 +28,8 @@ class NullDevice;
 #include "bspf.hxx"
 #include "Device.hxx"
 #include "NullDev.hxx"
+#include "PerfCounters.hxx"
+#include "Random.hxx"
 #include "Serializable.hxx"
 
 /**
@@ -40,11 +42,9 @@ class NullDevice;
   In general the addressing space will be 8192 (2^13) bytes for a 
   6507 based system and 65536 (2^16) bytes for a 6502 based system.
 
-  TODO: To allow for dynamic code generation we probably need to
-        add a tag to each page that indicates if it is read only
-        memory.  We also need to notify the processor anytime a
-        page access method is changed so that it can clear the
-        dynamic code for that page of memory.
+  The processor is notified anytime a page access method is changed,
+  so that it can keep its own copy of the direct access pointers and
+  bypass peek() and poke() for directly mapped memory.
 
   @author  Bradford W. Mott
   @version $Id: System.hxx,v 1.20 2009-01-01 18:13:38 stephena Exp $
@@ -150,6 +150,29 @@ class System : public Serializable
       return myNullDevice;
     }
 
+    /**
+      Get the random number generator associated with the system.
+      Devices use this (rather than a global generator) to randomize
+      their power-on state, so each system is fully independent.
+
+      @return The random number generator associated with the system
+    */
+    Random& randGenerator()
+    {
+      return myRandom;
+    }
+
+    /**
+      Get the performance counters of the system, which the processor
+      and devices add to as they run.
+
+      @return The performance counters of the system
+    */
+    PerfCounters& counters()
+    {
+      return myCounters;
+    }
+
     /**
       Get the total number of pages available in the system.
 
@@ -222,6 +245,20 @@ class System : public Serializable
       return myDataBusState;
     }
 
+    /**
+      Set the current state of the data bus.  This is used by the
+      processor for reads it satisfies itself without calling peek().
+
+      @param value  The data now on the bus
+    */
+    inline void setDataBusState(uInt8 value)
+    {
+#ifdef DEBUGGER_SUPPORT
+      if(!myDataBusLocked)
+#endif
+        myDataBusState = value;
+    }
+
     /**
       Get the byte at the specified address.  No masking of the
       address occurs before it's sent to the device mapped at
@@ -280,6 +317,9 @@ class System : public Serializable
         null device if the page hasn't been mapped to a device
       */
       Device* device;
+
+      PageAccess()
+        : directPeekBase(0), directPokeBase(0), device(0) { }
     };
 
     /**
@@ -358,6 +398,12 @@ class System : public Serializable
     // Null device to use for page which are not installed
     NullDevice myNullDevice; 
 
+    // Random number generator used by the attached devices
+    Random myRandom;
+
+    // Counters of the work done by the processor and devices
+    PerfCounters myCounters;
+
     // The current state of the Data Bus
     uInt8 myDataBusState;
 
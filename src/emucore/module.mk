@@ -2,6 +2,7 @@ MODULE := src/emucore
 
 MODULE_OBJS := \
 	src/emucore/AtariVox.o \
+	src/emucore/BlipBuffer.o \
 	src/emucore/Booster.o \
 	src/emucore/Cart2K.o \
 	src/emucore/Cart3F.o \
@@ -29,23 +30,30 @@ MODULE_OBJS := \
 	src/emucore/Cart0840.o \
 	src/emucore/CartX07.o \
 	src/emucore/Console.o \
+	src/emucore/ConsoleUI.o \
 	src/emucore/Control.o \
 	src/emucore/Deserializer.o \
+	src/emucore/DetectionCache.o \
 	src/emucore/Driving.o \
 	src/emucore/Event.o \
 	src/emucore/EventHandler.o \
 	src/emucore/FrameBuffer.o \
 	src/emucore/FSNode.o \
+	src/emucore/HashLog.o \
 	src/emucore/Joystick.o \
 	src/emucore/Keyboard.o \
 	src/emucore/M6532.o \
 	src/emucore/MT24LC256.o \
 	src/emucore/MD5.o \
+	src/emucore/Movie.o \
 	src/emucore/OSystem.o \
 	src/emucore/Paddles.o \
+	src/emucore/PerfCounters.o \
 	src/emucore/Props.o \
 	src/emucore/PropsSet.o \
 	src/emucore/Random.o \
+	src/emucore/RewindBuffer.o \
+	src/emucore/RunAhead.o \
 	src/emucore/SaveKey.o \
 	src/emucore/Serializer.o \
 	src/emucore/Settings.o \
@@ -20,7 +20,6 @@
 #include "Dialog.hxx"
 #include "Stack.hxx"
 #include "EventHandler.hxx"
-#include "Joystick.hxx"
 #include "bspf.hxx"
 #include "DialogContainer.hxx"
 
@@ -286,7 +285,7 @@ void DialogContainer::handleJoyAxisEvent(int stick, int axis, int value)
   // Send the event to the dialog box on the top of the stack
   Dialog* activeDialog = myDialogStack.top();
 
-  int deadzone = Joystick::deadzone();
+  int deadzone = myOSystem->eventHandler().joyDeadZone();
   if(value > deadzone)
     value -= deadzone;
   else if(value < -deadzone )
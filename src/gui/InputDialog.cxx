@@ -20,8 +20,8 @@
 
 #include "Array.hxx"
 #include "OSystem.hxx"
-#include "Joystick.hxx"
-#include "Paddles.hxx"
+#include "Console.hxx"
+#include "EventHandler.hxx"
 #include "Settings.hxx"
 #include "StringList.hxx"
 #include "EventMappingWidget.hxx"
@@ -189,9 +189,10 @@ void InputDialog::loadConfig()
   myDeadzone->setValue(instance().settings().getInt("joydeadzone"));
   myDeadzoneLabel->setLabel(instance().settings().getString("joydeadzone"));
 
-  // Paddle mode
-  myPaddleMode->setValue(0);
-  myPaddleModeLabel->setLabel("0");
+  // Paddle mode (-1 means the ROM default, which is shown as paddle 0)
+  int mode = BSPF_max(instance().settings().getInt("mpaddle"), 0);
+  myPaddleMode->setValue(mode);
+  myPaddleModeLabel->setValue(mode);
 
   // Paddle speed
   myPaddleSpeed->setValue(instance().settings().getInt("pspeed"));
@@ -214,15 +215,19 @@ void InputDialog::saveConfig()
   // Joystick deadzone
   int deadzone = myDeadzone->getValue();
   instance().settings().setInt("joydeadzone", deadzone);
-  Joystick::setDeadZone(deadzone);
+  instance().eventHandler().setJoyDeadZone(deadzone);
 
   // Paddle mode
-  Paddles::setMouseIsPaddle(myPaddleMode->getValue());
+  int mode = myPaddleMode->getValue();
+  instance().settings().setInt("mpaddle", mode);
+  if(&instance().console())
+    instance().console().setPaddleMode(mode);
 
   // Paddle speed
   int speed = myPaddleSpeed->getValue();
   instance().settings().setInt("pspeed", speed);
-  Paddles::setDigitalSpeed(speed);
+  if(&instance().console())
+    instance().console().setPaddleSpeed(speed);
 
   // AtariVox serial port
   instance().settings().setString("avoxport", myAVoxPort->getEditString());
@@ -0,0 +1,249 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <cstring>
+
+#include "Serializer.hxx"
+#include "Deserializer.hxx"
+#include "TIASnd.hxx"
+
+#include "SoundBuffer.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SoundBuffer::SoundBuffer(Int32 frequency, Int32 tiafreq)
+  : Sound(0),
+    myIsEnabled(true),
+    myIsInitializedFlag(false),
+    myIsMuted(false),
+    myLastRegisterSetCycle(0),
+    myFrequency(frequency),
+    mySampleFraction(0.0),
+    myNumChannels(1),
+    myVolume(100),
+    myBuffer(0),
+    mySize(0),
+    myCapacity(0)
+{
+  myTIASound.outputFrequency(frequency);
+  myTIASound.tiaFrequency(tiafreq);
+
+  // Enough for one NTSC frame at the default frequency, in stereo
+  reserve(1024);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SoundBuffer::~SoundBuffer()
+{
+  delete[] myBuffer;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundBuffer::setEnabled(bool enable)
+{
+  myIsEnabled = enable;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundBuffer::adjustCycleCounter(Int32 amount)
+{
+  myLastRegisterSetCycle += amount;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundBuffer::setChannels(uInt32 channels)
+{
+  if(channels == 1 || channels == 2)
+    myNumChannels = channels;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundBuffer::open()
+{
+  mySize = 0;
+  myTIASound.reset();
+  myLastRegisterSetCycle = 0;
+  mySampleFraction = 0.0;
+
+  if(!myIsEnabled)
+  {
+    close();
+    return;
+  }
+
+  myTIASound.channels(myNumChannels);
+  myTIASound.volume(myVolume);
+  myIsInitializedFlag = true;
+  myIsMuted = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundBuffer::close()
+{
+  myIsInitializedFlag = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundBuffer::reset()
+{
+  myIsMuted = false;
+  myLastRegisterSetCycle = 0;
+  mySampleFraction = 0.0;
+  myTIASound.reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundBuffer::set(uInt16 addr, uInt8 value, Int32 cycle)
+{
+  update(cycle);
+  myTIASound.set(addr, value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundBuffer::setVolume(Int32 percent)
+{
+  if((percent >= 0) && (percent <= 100))
+  {
+    myVolume = percent;
+    myTIASound.volume(percent);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundBuffer::adjustVolume(Int8 direction)
+{
+  Int32 percent = myVolume;
+
+  if(direction == -1)
+    percent -= 2;
+  else if(direction == 1)
+    percent += 2;
+
+  setVolume(percent);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundBuffer::update(Int32 cycle)
+{
+  if(!myIsInitializedFlag || cycle <= myLastRegisterSetCycle)
+  {
+    myLastRegisterSetCycle = cycle;
+    return;
+  }
+
+  // Work out how many samples the elapsed time corresponds to on a
+  // real 2600, carrying the remainder over to the next update
+  double samples = mySampleFraction +
+    ((double)(cycle - myLastRegisterSetCycle) * myFrequency) / 1193191.66666667;
+  uInt32 count = (uInt32)samples;
+  mySampleFraction = samples - count;
+  myLastRegisterSetCycle = cycle;
+
+  if(count == 0)
+    return;
+
+  reserve(mySize + count);
+  uInt8* stream = myBuffer + mySize * myNumChannels;
+  if(myIsMuted)
+    memset(stream, 128, count * myNumChannels);
+  else
+    myTIASound.process(stream, count);
+  mySize += count;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundBuffer::reserve(uInt32 samples)
+{
+  if(samples <= myCapacity)
+    return;
+
+  uInt32 capacity = myCapacity > 0 ? myCapacity : 1024;
+  while(capacity < samples)
+    capacity *= 2;
+
+  // Always allocate room for stereo, so the channels can be changed
+  // without reallocating
+  uInt8* buffer = new uInt8[capacity * 2];
+  if(myBuffer)
+  {
+    memcpy(buffer, myBuffer, mySize * myNumChannels);
+    delete[] myBuffer;
+  }
+  myBuffer = buffer;
+  myCapacity = capacity;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundBuffer::load(Deserializer& in)
+{
+  string device = "TIASound";
+
+  try
+  {
+    if(in.getString() != device)
+      return false;
+
+    uInt8 reg[6];
+    for(int i = 0; i < 6; ++i)
+      reg[i] = (uInt8) in.getByte();
+
+    myLastRegisterSetCycle = (Int32) in.getInt();
+
+    for(int i = 0; i < 6; ++i)
+      myTIASound.set(0x15 + i, reg[i]);
+  }
+  catch(char *msg)
+  {
+    cerr << msg << endl;
+    return false;
+  }
+  catch(...)
+  {
+    cerr << "Unknown error in load state for " << device << endl;
+    return false;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundBuffer::save(Serializer& out)
+{
+  string device = "TIASound";
+
+  try
+  {
+    out.putString(device);
+
+    for(int i = 0; i < 6; ++i)
+      out.putByte((char)myTIASound.get(0x15 + i));
+
+    out.putInt(myLastRegisterSetCycle);
+  }
+  catch(char *msg)
+  {
+    cerr << msg << endl;
+    return false;
+  }
+  catch(...)
+  {
+    cerr << "Unknown error in save state for " << device << endl;
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,238 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef SOUND_BUFFER_HXX
+#define SOUND_BUFFER_HXX
+
+class Serializer;
+class Deserializer;
+
+#include "bspf.hxx"
+#include "TIASnd.hxx"
+#include "Sound.hxx"
+
+/**
+  This class implements a sound object which doesn't need any audio
+  device.  TIA sound register writes are rendered immediately into a
+  growable sample buffer, which the owner empties once per frame.
+  It's used by the headless core library, where the caller decides
+  what to do with the samples.
+
+  Samples are unsigned 8-bit, interleaved when in stereo mode (the same
+  format TIASound generates for SoundSDL).
+
+  @author  Stella team
+  @version $Id$
+*/
+class SoundBuffer : public Sound
+{
+  public:
+    /**
+      Create a new sound buffer generating samples at the given frequency.
+
+      @param frequency  The output sample rate
+      @param tiafreq    The frequency of the TIA sound generator
+    */
+    SoundBuffer(Int32 frequency = 31400, Int32 tiafreq = 31400);
+
+    /**
+      Destructor
+    */
+    virtual ~SoundBuffer();
+
+  public:
+    /**
+      Enables/disables sample generation.
+
+      @param enable  Either true or false, to enable or disable the sound system
+    */
+    void setEnabled(bool enable);
+
+    /**
+      The system cycle counter is being adjusting by the specified amount.  Any
+      members using the system cycle counter should be adjusted as needed.
+
+      @param amount The amount the cycle counter is being adjusted by
+    */
+    void adjustCycleCounter(Int32 amount);
+
+    /**
+      Sets the number of channels (mono or stereo sound).
+
+      @param channels The number of channels
+    */
+    void setChannels(uInt32 channels);
+
+    /**
+      Sets the display framerate.  Samples are generated according to the
+      emulated CPU clock, so this isn't needed here.
+
+      @param framerate The base framerate depending on NTSC or PAL ROM
+    */
+    void setFrameRate(float framerate) { }
+
+    /**
+      Initializes the sound buffer.  This must be called before any
+      samples will be generated.
+    */
+    void open();
+
+    /**
+      Stops generating samples, until open is called again.
+    */
+    void close();
+
+    /**
+      Return true iff the sound buffer was successfully initialized.
+
+      @return true iff the sound buffer was successfully initialized.
+    */
+    bool isSuccessfullyInitialized() const { return myIsInitializedFlag; }
+
+    /**
+      Set the mute state of the sound object.  While muted silence is
+      generated instead of the TIA output.
+
+      @param state Mutes sound if true, unmute if false
+    */
+    void mute(bool state) { myIsMuted = state; }
+
+    /**
+      Reset the sound device.
+    */
+    void reset();
+
+    /**
+      Sets the sound register to a given value, first generating all
+      samples up to the given cycle with the previous register values.
+
+      @param addr  The register address
+      @param value The value to save into the register
+      @param cycle The system cycle at which the register is being updated
+    */
+    void set(uInt16 addr, uInt8 value, Int32 cycle);
+
+    /**
+      Sets the volume of the generated samples, as a percentage from
+      0 to 100.  Values outside this range are ignored.
+
+      @param percent The new volume percentage level
+    */
+    void setVolume(Int32 percent);
+
+    /**
+      Adjusts the volume based on the given direction.
+
+      @param direction  Increase or decrease the current volume by a predefined
+                        amount based on the direction (1 = increase, -1 =decrease)
+    */
+    void adjustVolume(Int8 direction);
+
+  public:
+    /**
+      Loads the current state of this device from the given Deserializer.
+
+      @param in The deserializer device to load from.
+      @return The result of the load.  True on success, false on failure.
+    */
+    bool load(Deserializer& in);
+
+    /**
+      Saves the current state of this device to the given Serializer.
+
+      @param out The serializer device to save to.
+      @return The result of the save.  True on success, false on failure.
+    */
+    bool save(Serializer& out);
+
+  public:
+    /**
+      Generate all samples up to the given system cycle, using the
+      current register values.  This is normally called at the end of
+      each frame.
+
+      @param cycle  The current system cycle
+    */
+    void update(Int32 cycle);
+
+    /**
+      Remove all samples from the buffer.
+    */
+    void clear() { mySize = 0; }
+
+    /**
+      Answers the samples generated since the last call to clear().
+
+      @return  Pointer to the sample data
+    */
+    const uInt8* samples() const { return myBuffer; }
+
+    /**
+      Answers the number of samples in the buffer (in stereo mode, each
+      sample consists of two bytes).
+
+      @return  The number of samples
+    */
+    uInt32 size() const { return mySize; }
+
+    /**
+      Answers the number of channels samples are generated for.
+
+      @return  1 for mono, 2 for stereo
+    */
+    uInt32 channels() const { return myNumChannels; }
+
+  private:
+    // Make sure the buffer can hold at least the given number of samples
+    void reserve(uInt32 samples);
+
+  private:
+    // TIASound emulation object
+    TIASound myTIASound;
+
+    // Indicates if samples are to be generated
+    bool myIsEnabled;
+
+    // Indicates if the buffer was successfully initialized
+    bool myIsInitializedFlag;
+
+    // Indicates if the sound is currently muted
+    bool myIsMuted;
+
+    // Indicates the cycle up to which samples have been generated
+    Int32 myLastRegisterSetCycle;
+
+    // The output sample rate
+    Int32 myFrequency;
+
+    // Fraction of a sample not yet generated at myLastRegisterSetCycle
+    double mySampleFraction;
+
+    // Indicates the number of channels (mono or stereo)
+    uInt32 myNumChannels;
+
+    // Current volume as a percentage (0 - 100)
+    uInt32 myVolume;
+
+    // The generated samples
+    uInt8* myBuffer;
+    uInt32 mySize;
+    uInt32 myCapacity;
+};
+
+#endif
@@ -0,0 +1,175 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <cassert>
+
+#include "Console.hxx"
+#include "Event.hxx"
+#include "Props.hxx"
+#include "System.hxx"
+#include "TIA.hxx"
+#include "StellaCore.hxx"
+
+#include "StellaBatch.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StellaBatch::StellaBatch(uInt32 threads)
+  : myPool(threads),
+    myStepTask(*this),
+    myFrameBuffers(0),
+    myRewards(0),
+    myInputs(0),
+    myRepeat(1)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StellaBatch::~StellaBatch()
+{
+  for(uInt32 i = 0; i < myEnvironments.size(); ++i)
+    delete myEnvironments[i].core;
+
+  delete[] myFrameBuffers;
+  delete[] myRewards;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StellaBatch::addConsole(const uInt8* image, uInt32 size,
+                             const Properties& props)
+{
+  StellaCore* core = new StellaCore();
+  if(!core->createConsole(image, size, props))
+  {
+    delete core;
+    return false;
+  }
+
+  Environment env;
+  env.core = core;
+  env.scoreBytes = 0;
+  env.scoreBCD = false;
+  env.lastScore = 0;
+  myEnvironments.push_back(env);
+
+  // Grow the result arrays; they're only ever read between steps
+  uInt32 n = myEnvironments.size();
+  const uInt8** buffers = new const uInt8*[n];
+  Int32* rewards = new Int32[n];
+  for(uInt32 i = 0; i < n - 1; ++i)
+  {
+    buffers[i] = myFrameBuffers[i];
+    rewards[i] = myRewards[i];
+  }
+  buffers[n-1] = core->frameBuffer();
+  rewards[n-1] = 0;
+
+  delete[] myFrameBuffers;
+  delete[] myRewards;
+  myFrameBuffers = buffers;
+  myRewards = rewards;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StellaCore& StellaBatch::core(uInt32 index) const
+{
+  assert(index < myEnvironments.size());
+  return *myEnvironments[index].core;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaBatch::setScore(uInt32 index, const uInt16* addresses,
+                           uInt32 count, bool bcd)
+{
+  assert(index < myEnvironments.size() && count <= 4);
+
+  Environment& env = myEnvironments[index];
+  for(uInt32 i = 0; i < count; ++i)
+    env.scoreAddress[i] = addresses[i];
+  env.scoreBytes = count;
+  env.scoreBCD = bcd;
+  env.lastScore = score(index);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaBatch::reset(uInt32 index)
+{
+  assert(index < myEnvironments.size());
+
+  Environment& env = myEnvironments[index];
+  env.core->console().system().reset();
+  env.lastScore = score(index);
+  myRewards[index] = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaBatch::step(const Event* inputs, uInt32 repeat)
+{
+  myInputs = inputs;
+  myRepeat = repeat > 0 ? repeat : 1;
+
+  myPool.run(myStepTask, myEnvironments.size());
+
+  myInputs = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 StellaBatch::score(uInt32 index) const
+{
+  const Environment& env = myEnvironments[index];
+
+  Int32 value = 0;
+  for(uInt32 i = 0; i < env.scoreBytes; ++i)
+  {
+    uInt8 byte = env.core->peekRAM(env.scoreAddress[i]);
+    if(env.scoreBCD)
+      value = value * 100 + (byte >> 4) * 10 + (byte & 0x0f);
+    else
+      value = (value << 8) | byte;
+  }
+  return value;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaBatch::stepConsole(uInt32 index)
+{
+  // Each console (and its environment) is only ever touched by one
+  // thread during a step, so no locking is needed here
+  Environment& env = myEnvironments[index];
+  TIA& tia = env.core->console().tia();
+
+  // Only the last frame is returned, so don't draw the others
+  tia.setRenderSkip(myRepeat > 1);
+  if(myInputs)
+    env.core->stepFrame(myInputs[index]);
+  else
+    env.core->stepFrame();
+  for(uInt32 i = 1; i < myRepeat; ++i)
+  {
+    if(i == myRepeat - 1)
+      tia.setRenderSkip(false);
+    env.core->stepFrame();
+  }
+
+  Int32 value = score(index);
+  myRewards[index] = value - env.lastScore;
+  env.lastScore = value;
+
+  myFrameBuffers[index] = env.core->frameBuffer();
+}
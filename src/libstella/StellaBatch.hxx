@@ -0,0 +1,193 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef STELLA_BATCH_HXX
+#define STELLA_BATCH_HXX
+
+class Event;
+class Properties;
+class StellaCore;
+
+#include "bspf.hxx"
+#include "Array.hxx"
+#include "ThreadPool.hxx"
+
+/**
+  This class runs many independent consoles in lockstep, for clients
+  (such as agent training) which need a large number of environment
+  steps per second.  Each call to step() advances every console by the
+  same number of frames, spreading the consoles over a work-stealing
+  thread pool, and then makes the framebuffers and rewards of all
+  consoles available as plain arrays.
+
+  The reward of a console is the change in its score since the previous
+  step, where the score is read from a set of RIOT RAM locations
+  (most significant byte first, usually in BCD as most games store it).
+
+    StellaBatch batch;
+    for(...) batch.addConsole(image, size, props);
+    batch.setScore(0, addresses, 3);
+    for(;;)
+    {
+      batch.step(inputs, 4);   // 4 frames with the same input
+      ... batch.frameBuffers()[i], batch.rewards()[i] ...
+    }
+
+  @author  Stella team
+  @version $Id$
+*/
+class StellaBatch
+{
+  public:
+    /**
+      Create a new, empty batch.
+
+      @param threads  The number of threads to use, or 0 to use one for
+                      each processor
+    */
+    StellaBatch(uInt32 threads = 0);
+
+    /**
+      Destructor
+    */
+    virtual ~StellaBatch();
+
+  public:
+    /**
+      Creates a new console for the given ROM image, and adds it at the
+      end of the batch.
+
+      @param image  The ROM image
+      @param size   The size of the ROM image
+      @param props  The properties for the ROM
+
+      @return  False on any errors, else true
+    */
+    bool addConsole(const uInt8* image, uInt32 size, const Properties& props);
+
+    /**
+      Answers the number of consoles in the batch.
+    */
+    uInt32 size() const { return myEnvironments.size(); }
+
+    /**
+      Get the core for the given console, for any access not covered
+      by this class (sound, settings, etc).
+    */
+    StellaCore& core(uInt32 index) const;
+
+    /**
+      Defines where the score of a console is located in RIOT RAM.
+      A console without a score always has a reward of zero.
+
+      @param index      The console
+      @param addresses  The RAM addresses (0x80 - 0xff), most significant first
+      @param count      The number of addresses (at most 4)
+      @param bcd        Whether the score is stored as BCD digits
+    */
+    void setScore(uInt32 index, const uInt16* addresses, uInt32 count,
+                  bool bcd = true);
+
+    /**
+      Resets the given console, as if the power was cycled.
+    */
+    void reset(uInt32 index);
+
+    /**
+      Advance all consoles by the given number of frames.
+
+      @param inputs  One event per console, holding the controller and
+                     switch state used for all frames of this step; if
+                     this is null, each core's own event object is used
+      @param repeat  The number of frames to emulate; only the last
+                     one is rendered, the others are emulated in
+                     render-skip mode
+    */
+    void step(const Event* inputs, uInt32 repeat = 1);
+
+  public:
+    /**
+      Answers the framebuffer of each console for the last completed frame.
+      See StellaCore::frameBuffer() for the format.
+    */
+    const uInt8* const* frameBuffers() const { return myFrameBuffers; }
+
+    /**
+      Answers the reward of each console for the last step.
+    */
+    const Int32* rewards() const { return myRewards; }
+
+    /**
+      Answers the number of threads in use.
+    */
+    uInt32 threads() const { return myPool.threads(); }
+
+  private:
+    // Answers the score of the given console
+    Int32 score(uInt32 index) const;
+
+    // Called by the thread pool to step one console
+    void stepConsole(uInt32 index);
+
+  private:
+    // Everything we keep for each console
+    struct Environment
+    {
+      StellaCore* core;
+      uInt16 scoreAddress[4];
+      uInt32 scoreBytes;
+      bool scoreBCD;
+      Int32 lastScore;
+    };
+
+    // Used to run stepConsole() from the pool
+    class StepTask : public ThreadPool::Task
+    {
+      public:
+        StepTask(StellaBatch& batch) : myBatch(batch) { }
+        void execute(uInt32 index) { myBatch.stepConsole(index); }
+
+      private:
+        StellaBatch& myBatch;
+    };
+    friend class StepTask;
+
+    // The thread pool, and the task it runs on each step
+    ThreadPool myPool;
+    StepTask myStepTask;
+
+    // The consoles in the batch
+    Common::Array<Environment> myEnvironments;
+
+    // One framebuffer pointer and reward per console
+    const uInt8** myFrameBuffers;
+    Int32* myRewards;
+
+    // Parameters of the step being run
+    const Event* myInputs;
+    uInt32 myRepeat;
+
+  private:
+    // Copy constructor isn't supported by this class so make it private
+    StellaBatch(const StellaBatch&);
+
+    // Assignment operator isn't supported by this class so make it private
+    StellaBatch& operator = (const StellaBatch&);
+};
+
+#endif
@@ -0,0 +1,342 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+/*
+  The ROM corpus benchmark.  Every ROM in the given directories is run
+  headlessly for a fixed number of frames, with the same scripted input
+  each time, and the throughput is reported per ROM and per bankswitch
+  type.  A hash of every frame is folded into one value per ROM, which
+  can be saved as a 'golden' file and compared on later runs, so the
+  same run catches both performance regressions and changed behaviour.
+
+    stellabench [-frames <n>] [-golden <file>] [-update] [-rgba] <dir|rom> ...
+
+  With -update, the golden file given by -golden is (re)written instead of
+  compared.  With -rgba, every frame is also captured as 32-bit pixels
+  and checked against a palette lookup of the TIA framebuffer.  The exit
+  status is non-zero if any ROM failed to load or didn't match.
+*/
+
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <vector>
+#include <algorithm>
+
+#include "Cart.hxx"
+#include "Console.hxx"
+#include "FSNode.hxx"
+#include "HashLog.hxx"
+#include "MD5.hxx"
+#include "M6502.hxx"
+#include "PerfCounters.hxx"
+#include "Props.hxx"
+#include "System.hxx"
+
+#include "StellaCore.hxx"
+
+// The results for one ROM, or the totals for one bankswitch type
+struct Result {
+  uInt32 roms;
+  uInt32 frames;
+  uInt64 micros;
+  uInt64 instructions;
+  uInt64 pokes;
+
+  Result() : roms(0), frames(0), micros(0), instructions(0), pokes(0) { }
+  void add(const Result& r)
+  {
+    roms += r.roms;  frames += r.frames;  micros += r.micros;
+    instructions += r.instructions;  pokes += r.pokes;
+  }
+};
+
+typedef map<string, string> GoldenMap;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void setInput(Event& event, uInt32 frame)
+{
+  // Press reset briefly (to get past most title screens), then move both
+  // joysticks around in a fixed pseudo-random pattern, firing now and then
+  event.clear();
+  if(frame >= 30 && frame < 40)
+  {
+    event.set(Event::ConsoleReset, 1);
+    return;
+  }
+
+  uInt32 step = (frame / 16) * 1103515245 + 12345;
+  uInt32 dir = (step >> 16) & 0x0f;
+  bool fire  = (frame / 8) % 3 == 0;
+
+  event.set(Event::JoystickZeroUp,    dir & 0x01);
+  event.set(Event::JoystickZeroDown,  (dir & 0x03) == 0x02);
+  event.set(Event::JoystickZeroLeft,  dir & 0x04);
+  event.set(Event::JoystickZeroRight, (dir & 0x0c) == 0x08);
+  event.set(Event::JoystickZeroFire1, fire);
+  event.set(Event::JoystickOneUp,     dir & 0x02);
+  event.set(Event::JoystickOneLeft,   dir & 0x08);
+  event.set(Event::JoystickOneFire1,  !fire);
+  event.set(Event::PaddleZeroFire,    fire);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static bool rgbaMatches(const StellaCore& core)
+{
+  // The captured frame must be exactly the framebuffer looked up in the
+  // palette, including any scanlines the frame didn't draw
+  const uInt8* frame = core.frameBuffer();
+  const uInt32* rgba = core.rgbaFrame();
+  const uInt32* palette = core.palette();
+  uInt32 pixels = core.width() * core.height();
+  for(uInt32 i = 0; i < pixels; ++i)
+    if(rgba[i] != palette[frame[i]])
+      return false;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static bool runRom(const string& filename, uInt32 frames, bool rgba,
+                   string& md5, string& type, uInt64& hash, bool& rgbaOk,
+                   Result& result)
+{
+  ifstream in(filename.c_str(), ios::in | ios::binary);
+  if(!in)
+    return false;
+  in.seekg(0, ios::end);
+  streampos length = in.tellg();
+  in.seekg(0, ios::beg);
+  if(length <= 0 || length > 512 * 1024)
+    return false;
+
+  uInt32 size = (uInt32) length;
+  uInt8* image = new uInt8[size];
+  in.read((char*)image, size);
+  bool ok = !in.bad();
+  in.close();
+
+  if(ok)
+  {
+    md5  = MD5(image, size);
+    type = Cartridge::autodetectType(image, size);
+
+    Properties props;
+    props.set(Cartridge_MD5, md5);
+    StellaCore core;
+    core.enableRGBAFrame(rgba);
+    rgbaOk = true;
+    ok = core.createConsole(image, size, props);
+    if(ok)
+    {
+      // The core seeds its random number generator with a fixed value,
+      // so the initial RAM and CPU registers are the same on every run
+      System& system = core.console().system();
+
+      PerfCounters& counters = system.counters();
+      counters.setCounting(true);
+      M6502& cpu = system.m6502();
+      HashLog hasher;
+      hash = 14695981039346656037ULL;
+
+      // Only the emulation is timed, not the hashing
+      for(uInt32 frame = 0; frame < frames; ++frame)
+      {
+        setInput(core.event(), frame);
+
+        uInt32 instructions = (uInt32) cpu.totalInstructionCount();
+        uInt32 pokes = counters.total(PerfCounters::TIAPokes);
+        uInt32 start = PerfCounters::ticks();
+        core.stepFrame();
+        result.micros += PerfCounters::ticks() - start;
+        result.instructions +=
+          (uInt32) cpu.totalInstructionCount() - instructions;
+        result.pokes += counters.total(PerfCounters::TIAPokes) - pokes;
+
+        hash = (hash ^ hasher.hash(core.console())) * 1099511628211ULL;
+        if(rgba && rgbaOk)
+          rgbaOk = rgbaMatches(core);
+      }
+      result.roms   = 1;
+      result.frames = frames;
+    }
+  }
+  delete[] image;
+
+  return ok;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void printResult(const string& name, const string& type,
+                        const Result& r, const char* status)
+{
+  double seconds = r.micros > 0 ? r.micros / 1000000.0 : 1e-6;
+  printf("%-32.32s %-6s %10.1f %8.2f %10.0f  %s\n", name.c_str(),
+         type.c_str(), r.frames / seconds, r.instructions / seconds / 1e6,
+         r.pokes / seconds, status);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void addPath(const string& path, vector<string>& roms)
+{
+  FilesystemNode node(path);
+  if(!node.exists())
+    return;
+
+  if(!node.isDirectory())
+  {
+    roms.push_back(node.getPath());
+    return;
+  }
+
+  FSList files;
+  if(!node.getChildren(files, FilesystemNode::kListFilesOnly))
+    return;
+
+  vector<string> names;
+  for(unsigned int i = 0; i < files.size(); ++i)
+    names.push_back(files[i].getPath());
+
+  sort(names.begin(), names.end());
+  roms.insert(roms.end(), names.begin(), names.end());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int argc, char* argv[])
+{
+  uInt32 frames = 600;
+  string goldenfile;
+  bool update = false, rgba = false;
+  vector<string> roms;
+
+  for(int i = 1; i < argc; ++i)
+  {
+    string arg = argv[i];
+    if(arg == "-frames" && i + 1 < argc)
+      frames = atoi(argv[++i]);
+    else if(arg == "-golden" && i + 1 < argc)
+      goldenfile = argv[++i];
+    else if(arg == "-update")
+      update = true;
+    else if(arg == "-rgba")
+      rgba = true;
+    else
+      addPath(arg, roms);
+  }
+  if(roms.empty() || frames == 0)
+  {
+    cerr << "Usage: stellabench [-frames <n>] [-golden <file>] [-update] "
+         << "[-rgba] <dir|rom> ..." << endl;
+    return 2;
+  }
+  if(update && goldenfile == "")
+  {
+    cerr << "ERROR: -update needs a golden file to write (-golden <file>)"
+         << endl;
+    return 2;
+  }
+
+  // The golden file has one 'md5 hash' line per ROM
+  GoldenMap golden;
+  if(goldenfile != "")
+  {
+    ifstream in(goldenfile.c_str());
+    string md5, hash;
+    while(in >> md5 >> hash)
+      golden[md5] = hash;
+  }
+
+  printf("%-32s %-6s %10s %8s %10s  %s\n", "ROM", "Type", "Frames/s",
+         "MIPS", "Pokes/s", "Hash");
+
+  map<string, Result> types;
+  Result total;
+  int failures = 0;
+  for(unsigned int i = 0; i < roms.size(); ++i)
+  {
+    string name = FilesystemNode(roms[i]).getName();
+    string md5, type;
+    uInt64 hash = 0;
+    bool rgbaOk = true;
+    Result result;
+    if(!runRom(roms[i], frames, rgba, md5, type, hash, rgbaOk, result))
+    {
+      printf("%-32.32s %-6s %10s %8s %10s  %s\n", name.c_str(), "?", "-",
+             "-", "-", "ERROR");
+      ++failures;
+      continue;
+    }
+
+    char hex[17];
+    sprintf(hex, "%08x%08x", (uInt32)(hash >> 32), (uInt32)hash);
+    const char* status = "-";
+    if(update)
+    {
+      golden[md5] = hex;
+      status = "saved";
+    }
+    else if(goldenfile != "")
+    {
+      GoldenMap::const_iterator it = golden.find(md5);
+      if(it == golden.end())
+        status = "new";
+      else if(it->second == hex)
+        status = "ok";
+      else
+      {
+        status = "MISMATCH";
+        ++failures;
+      }
+    }
+    if(!rgbaOk)
+    {
+      status = "RGBA";
+      ++failures;
+    }
+    printResult(name, type, result, status);
+
+    types[type].add(result);
+    total.add(result);
+  }
+
+  printf("\n%-32s %-6s %10s %8s %10s\n", "Type (ROMs)", "", "Frames/s",
+         "MIPS", "Pokes/s");
+  for(map<string, Result>::const_iterator it = types.begin();
+      it != types.end(); ++it)
+  {
+    char label[64];
+    sprintf(label, "%s (%u)", it->first.c_str(), it->second.roms);
+    printResult(label, "", it->second, "");
+  }
+  printResult("All", "", total, "");
+
+  if(update)
+  {
+    ofstream out(goldenfile.c_str());
+    for(GoldenMap::const_iterator it = golden.begin(); it != golden.end(); ++it)
+      out << it->first << " " << it->second << endl;
+    if(!out)
+    {
+      cerr << "ERROR: Couldn't write " << goldenfile << endl;
+      ++failures;
+    }
+  }
+
+  return failures > 0 ? 1 : 0;
+}
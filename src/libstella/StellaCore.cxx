@@ -0,0 +1,253 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include <cstring>
+
+#include "Cart.hxx"
+#include "Console.hxx"
+#include "Control.hxx"
+#include "Deserializer.hxx"
+#include "HashLog.hxx"
+#include "M6532.hxx"
+#include "MD5.hxx"
+#include "Movie.hxx"
+#include "Props.hxx"
+#include "Serializer.hxx"
+#include "Switches.hxx"
+#include "System.hxx"
+#include "TIA.hxx"
+
+#include "StellaCore.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StellaCore::StellaCore(uInt32 seed)
+  : mySettings(0),
+    myConsole(0),
+    mySeed(seed),
+    myRGBAFrame(0)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StellaCore::~StellaCore()
+{
+  deleteConsole();
+  delete[] myRGBAFrame;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StellaCore::createConsole(const uInt8* image, uInt32 size,
+                               const Properties& props)
+{
+  deleteConsole();
+
+  Properties properties(props);
+  if(properties.get(Cartridge_MD5) == "")
+    properties.set(Cartridge_MD5, MD5(image, size));
+
+  Cartridge* cart = Cartridge::create(image, size, properties, mySettings);
+  if(!cart)
+  {
+    cerr << "ERROR: Couldn't create cartridge" << endl;
+    return false;
+  }
+
+  myEvent.clear();
+  myConsole = new Console(cart, properties, mySettings, mySound, myEvent,
+                          mySeed);
+
+  // Sound generation depends on the console properties
+  const string& sound = myConsole->properties().get(Cartridge_Sound);
+  mySound.close();
+  mySound.setChannels(sound == "STEREO" ? 2 : 1);
+  mySound.setFrameRate(myConsole->getFramerate());
+  mySound.open();
+
+  attachRGBAFrame();
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaCore::deleteConsole()
+{
+  if(myConsole)
+  {
+    mySound.close();
+    delete myConsole;
+    myConsole = 0;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaCore::stepFrame()
+{
+  if(myConsole)
+  {
+    myConsole->controller(Controller::Left).update();
+    myConsole->controller(Controller::Right).update();
+    myConsole->switches().update();
+  }
+
+  emulateFrame();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaCore::stepFrame(const Event& input)
+{
+  for(int i = 0; i < Event::LastType; ++i)
+    myEvent.set((Event::Type)i, input.get((Event::Type)i));
+
+  stepFrame();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaCore::emulateFrame()
+{
+  mySound.clear();
+  if(!myConsole)
+    return;
+
+  myConsole->tia().update();
+  mySound.update(myConsole->system().cycles());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StellaCore::saveState(Serializer& out) const
+{
+  return myConsole && myConsole->save(out);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StellaCore::loadState(Deserializer& in)
+{
+  return myConsole && myConsole->load(in);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StellaCore::logMovie(const string& movie, const string& hashes)
+{
+  if(!myConsole)
+    return false;
+
+  Movie player;
+  HashLog log;
+  if(!player.startPlayback(movie, *myConsole) ||
+     !log.startLogging(hashes, *myConsole))
+    return false;
+
+  while(player.play(*myConsole))
+  {
+    emulateFrame();
+    if(!log.log(*myConsole))
+      return false;
+  }
+
+  return player.frame() == player.frames() && log.close();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StellaCore::verifyMovie(const string& movie, const string& hashes,
+                             uInt32& frame)
+{
+  frame = 0;
+  if(!myConsole)
+    return false;
+
+  Movie player;
+  HashLog log;
+  if(!player.startPlayback(movie, *myConsole) ||
+     !log.startVerifying(hashes, *myConsole))
+    return false;
+
+  // Stop at the first frame that differs (or when either one runs out)
+  while(player.play(*myConsole))
+  {
+    emulateFrame();
+    if(!log.verify(*myConsole))
+      break;
+  }
+
+  frame = log.frame();
+  return !log.diverged() && frame == player.frames();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt8* StellaCore::frameBuffer() const
+{
+  return myConsole ? myConsole->tia().currentFrameBuffer() : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 StellaCore::width() const
+{
+  return myConsole ? myConsole->tia().width() : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 StellaCore::height() const
+{
+  return myConsole ? myConsole->tia().height() : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt32* StellaCore::palette() const
+{
+  return myConsole ? myConsole->palette(mySettings.getString("palette")) : 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaCore::enableRGBAFrame(bool enable)
+{
+  if(enable && !myRGBAFrame)
+  {
+    // Big enough for the tallest frame the TIA allows
+    myRGBAFrame = new uInt32[160 * 300];
+    memset(myRGBAFrame, 0, 160 * 300 * sizeof(uInt32));
+  }
+  else if(!enable && myRGBAFrame)
+  {
+    if(myConsole)
+      myConsole->tia().setRGBAOutput(0, 0, 0);
+    delete[] myRGBAFrame;
+    myRGBAFrame = 0;
+  }
+
+  attachRGBAFrame();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt32* StellaCore::rgbaFrame() const
+{
+  return myRGBAFrame;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StellaCore::attachRGBAFrame()
+{
+  if(myConsole)
+    myConsole->tia().setRGBAOutput(myRGBAFrame, 160 * sizeof(uInt32),
+                                   myRGBAFrame ? palette() : 0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uInt8* StellaCore::ram() const
+{
+  static const uInt8 ourEmptyRAM[128] = { 0 };
+  return myConsole ? myConsole->riot().getRAM() : ourEmptyRAM;
+}
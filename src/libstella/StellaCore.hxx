@@ -0,0 +1,257 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef STELLA_CORE_HXX
+#define STELLA_CORE_HXX
+
+class Cartridge;
+class Console;
+class Deserializer;
+class Properties;
+class Serializer;
+
+#include "bspf.hxx"
+#include "Event.hxx"
+#include "Settings.hxx"
+#include "SoundBuffer.hxx"
+
+/**
+  This class is the public interface of the headless core library
+  (libstella).  It runs a complete Console without an OSystem, so there
+  is no framebuffer, event handler, sound device or SDL involved;
+  the caller feeds in the input for each frame, and reads back the
+  TIA framebuffer, the generated audio samples and the RIOT RAM.
+
+  A typical session looks like:
+
+    StellaCore core;
+    core.settings().setString("cpu", "high");   // optional
+    if(core.createConsole(image, size, props))
+    {
+      core.event().set(Event::JoystickZeroFire1, 1);
+      core.stepFrame();
+      ... core.frameBuffer(), core.samples(), core.ram() ...
+    }
+
+  @author  Stella team
+  @version $Id$
+*/
+class StellaCore
+{
+  public:
+    /**
+      Create a new core, without any console.
+
+      @param seed  The seed for the random number generator of every
+                   console created; the initial RAM and CPU registers
+                   depend on it, so the default makes runs repeatable
+    */
+    explicit StellaCore(uInt32 seed = 0);
+
+    /**
+      Destructor
+    */
+    virtual ~StellaCore();
+
+  public:
+    /**
+      Creates a new console for the given ROM image.  Any existing
+      console is destroyed first.  If the properties don't contain the
+      MD5 of the image, it will be calculated here.
+
+      @param image  The ROM image (it's copied by the cartridge)
+      @param size   The size of the ROM image
+      @param props  The properties for the ROM
+
+      @return  False on any errors, else true
+    */
+    bool createConsole(const uInt8* image, uInt32 size, const Properties& props);
+
+    /**
+      Destroys the current console (if any).
+    */
+    void deleteConsole();
+
+    /**
+      Answers whether a console has been created.
+    */
+    bool hasConsole() const { return myConsole != 0; }
+
+    /**
+      Get the console.  Only valid after createConsole has succeeded.
+    */
+    Console& console() const { return *myConsole; }
+
+    /**
+      Get the settings used when creating the console.  These should be
+      changed before calling createConsole.
+    */
+    Settings& settings() { return mySettings; }
+
+    /**
+      Get the event object holding the current state of the controllers
+      and console switches.  Values set here are seen by the next frame.
+    */
+    Event& event() { return myEvent; }
+
+    /**
+      Emulate one frame using the current state of the event object.
+      The audio samples from the previous frame are discarded.
+    */
+    void stepFrame();
+
+    /**
+      Emulate one frame, first copying all values from the given event
+      object into the one used by the console.
+
+      @param input  The controller and switch state for this frame
+    */
+    void stepFrame(const Event& input);
+
+    /**
+      Saves the complete state of the console.  Using a Serializer that
+      isn't opened on a file keeps the snapshot in memory, where it can
+      be restored again with a Deserializer opened on its data.
+
+      @param out  The Serializer object to use
+      @return  False on any errors, else true
+    */
+    bool saveState(Serializer& out) const;
+
+    /**
+      Restores a state previously saved with saveState.
+
+      @param in  The Deserializer object to use
+      @return  False on any errors, else true
+    */
+    bool loadState(Deserializer& in);
+
+    /**
+      Plays back a movie recorded for the current console, writing the
+      hash of every frame to a log (see HashLog).  Together with
+      verifyMovie, this checks that a change to the core doesn't alter
+      the emulation.
+
+      @param movie   The movie file to play back
+      @param hashes  The hash log file to write
+      @return  False on any errors, else true
+    */
+    bool logMovie(const string& movie, const string& hashes);
+
+    /**
+      Plays back a movie recorded for the current console, checking every
+      frame against a log written by logMovie, and stopping at the first
+      frame that differs.
+
+      @param movie   The movie file to play back
+      @param hashes  The hash log file to check against
+      @param frame   Receives the number of frames that matched
+      @return  True if every frame of the movie matched, else false
+    */
+    bool verifyMovie(const string& movie, const string& hashes, uInt32& frame);
+
+  public:
+    /**
+      Answers the TIA framebuffer for the last completed frame.  Each byte
+      is an index into the palette for the current display format.
+    */
+    const uInt8* frameBuffer() const;
+
+    /**
+      Answers the width and height of the framebuffer, in pixels.
+    */
+    uInt32 width() const;
+    uInt32 height() const;
+
+    /**
+      Answers the palette mapping framebuffer values to 32-bit pixels, for
+      the console's display format and the 'palette' setting.
+    */
+    const uInt32* palette() const;
+
+    /**
+      Enables/disables capturing every frame as 32-bit pixels as well.
+      The TIA maps each scanline through palette() as it finishes it, so
+      there's no separate pass over the frame.  This stays in effect for
+      any later console.
+    */
+    void enableRGBAFrame(bool enable);
+
+    /**
+      Answers the last completed frame as height() scanlines of width()
+      32-bit pixels, or 0 if capturing isn't enabled.
+    */
+    const uInt32* rgbaFrame() const;
+
+    /**
+      Answers the audio samples generated during the last frame (unsigned
+      8-bit, interleaved if the ROM uses stereo sound).
+    */
+    const uInt8* samples() const { return mySound.samples(); }
+    uInt32 sampleCount() const   { return mySound.size(); }
+    uInt32 channels() const      { return mySound.channels(); }
+
+    /**
+      Answers the 128 bytes of RIOT RAM.
+    */
+    const uInt8* ram() const;
+
+    /**
+      Answers a byte of RIOT RAM, with address in the range 0x80 - 0xff.
+    */
+    uInt8 peekRAM(uInt16 address) const { return ram()[address & 0x7f]; }
+
+  private:
+    // Settings used by the console and its devices
+    Settings mySettings;
+
+    // Receives all TIA sound register writes
+    SoundBuffer mySound;
+
+    // Controller and switch state
+    Event myEvent;
+
+    // The current console (if any)
+    Console* myConsole;
+
+    // Seed for the random number generator of each console
+    uInt32 mySeed;
+
+    // Receives every frame as 32-bit pixels, when enabled
+    uInt32* myRGBAFrame;
+
+  private:
+    /**
+      Emulate one frame with the controller and switch state as it is,
+      without updating it from the event object.
+    */
+    void emulateFrame();
+
+    /**
+      Point the current console's TIA at the RGBA frame (or at nothing).
+    */
+    void attachRGBAFrame();
+
+    // Copy constructor isn't supported by this class so make it private
+    StellaCore(const StellaCore&);
+
+    // Assignment operator isn't supported by this class so make it private
+    StellaCore& operator = (const StellaCore&);
+};
+
+#endif
@@ -0,0 +1,242 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#include "ThreadPool.hxx"
+
+#ifdef THREAD_POOL_PTHREADS
+  #include <unistd.h>
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThreadPool::ThreadPool(uInt32 threads)
+  : myNumThreads(threads > 0 ? threads : processors()),
+    myRanges(0),
+    myNumRanges(0),
+    myTask(0)
+{
+#ifndef THREAD_POOL_PTHREADS
+  myNumThreads = 1;
+#endif
+
+  // Thread creation may fail below, so remember how many ranges there are
+  myNumRanges = myNumThreads;
+  myRanges = new Range[myNumRanges];
+  for(uInt32 i = 0; i < myNumRanges; ++i)
+  {
+    myRanges[i].begin = myRanges[i].end = 0;
+#ifdef THREAD_POOL_PTHREADS
+    pthread_mutex_init(&myRanges[i].lock, NULL);
+#endif
+  }
+
+#ifdef THREAD_POOL_PTHREADS
+  pthread_mutex_init(&myLock, NULL);
+  pthread_cond_init(&myStartCond, NULL);
+  pthread_cond_init(&myDoneCond, NULL);
+  myGeneration = 0;
+  myBusyWorkers = 0;
+  myQuitFlag = false;
+
+  // The calling thread acts as thread 0, so only create the others
+  myThreads = new pthread_t[myNumThreads];
+  myWorkers = new Worker[myNumThreads];
+  for(uInt32 i = 1; i < myNumThreads; ++i)
+  {
+    myWorkers[i].pool = this;
+    myWorkers[i].thread = i;
+    if(pthread_create(&myThreads[i], NULL, workerMain, &myWorkers[i]) != 0)
+    {
+      // Continue with the threads we managed to create
+      cerr << "ERROR: Couldn't create worker thread " << i << endl;
+      myNumThreads = i;
+      break;
+    }
+  }
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ThreadPool::~ThreadPool()
+{
+#ifdef THREAD_POOL_PTHREADS
+  pthread_mutex_lock(&myLock);
+  myQuitFlag = true;
+  pthread_cond_broadcast(&myStartCond);
+  pthread_mutex_unlock(&myLock);
+
+  for(uInt32 i = 1; i < myNumThreads; ++i)
+    pthread_join(myThreads[i], NULL);
+
+  for(uInt32 i = 0; i < myNumRanges; ++i)
+    pthread_mutex_destroy(&myRanges[i].lock);
+  pthread_cond_destroy(&myDoneCond);
+  pthread_cond_destroy(&myStartCond);
+  pthread_mutex_destroy(&myLock);
+
+  delete[] myWorkers;
+  delete[] myThreads;
+#endif
+
+  delete[] myRanges;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThreadPool::run(Task& task, uInt32 count)
+{
+  if(count == 0)
+    return;
+
+  myTask = &task;
+
+  // Give each thread an (almost) equal share of the jobs
+  uInt32 share = count / myNumThreads, extra = count % myNumThreads;
+  uInt32 begin = 0;
+  for(uInt32 i = 0; i < myNumThreads; ++i)
+  {
+    myRanges[i].begin = begin;
+    begin += share + (i < extra ? 1 : 0);
+    myRanges[i].end = begin;
+  }
+
+#ifdef THREAD_POOL_PTHREADS
+  if(myNumThreads > 1)
+  {
+    pthread_mutex_lock(&myLock);
+    myBusyWorkers = myNumThreads - 1;
+    ++myGeneration;
+    pthread_cond_broadcast(&myStartCond);
+    pthread_mutex_unlock(&myLock);
+
+    work(0);
+
+    pthread_mutex_lock(&myLock);
+    while(myBusyWorkers > 0)
+      pthread_cond_wait(&myDoneCond, &myLock);
+    pthread_mutex_unlock(&myLock);
+  }
+  else
+#endif
+    work(0);
+
+  myTask = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 ThreadPool::processors()
+{
+#if defined(THREAD_POOL_PTHREADS) && defined(_SC_NPROCESSORS_ONLN)
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? (uInt32)n : 1;
+#else
+  return 1;
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ThreadPool::nextJob(uInt32 thread, uInt32& index)
+{
+#ifdef THREAD_POOL_PTHREADS
+  // First try our own range
+  Range& own = myRanges[thread];
+  pthread_mutex_lock(&own.lock);
+  bool found = own.begin < own.end;
+  if(found)
+    index = own.begin++;
+  pthread_mutex_unlock(&own.lock);
+  if(found)
+    return true;
+
+  // Then steal the back half of the first non-empty range we find
+  // Only one lock is held at a time, so two threads stealing from
+  // each other can't deadlock
+  for(uInt32 i = 1; i < myNumThreads; ++i)
+  {
+    Range& victim = myRanges[(thread + i) % myNumThreads];
+    uInt32 begin = 0, end = 0;
+
+    pthread_mutex_lock(&victim.lock);
+    uInt32 left = victim.end - victim.begin;
+    if(victim.begin < victim.end)
+    {
+      end = victim.end;
+      begin = victim.end - (left + 1) / 2;
+      victim.end = begin;
+    }
+    pthread_mutex_unlock(&victim.lock);
+
+    if(begin < end)
+    {
+      index = begin;
+      pthread_mutex_lock(&own.lock);
+      own.begin = begin + 1;
+      own.end = end;
+      pthread_mutex_unlock(&own.lock);
+      return true;
+    }
+  }
+  return false;
+#else
+  Range& own = myRanges[thread];
+  if(own.begin < own.end)
+  {
+    index = own.begin++;
+    return true;
+  }
+  return false;
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThreadPool::work(uInt32 thread)
+{
+  uInt32 index;
+  while(nextJob(thread, index))
+    myTask->execute(index);
+}
+
+#ifdef THREAD_POOL_PTHREADS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void* ThreadPool::workerMain(void* arg)
+{
+  Worker* worker = (Worker*) arg;
+  ThreadPool& pool = *worker->pool;
+  uInt32 generation = 0;
+
+  for(;;)
+  {
+    pthread_mutex_lock(&pool.myLock);
+    while(pool.myGeneration == generation && !pool.myQuitFlag)
+      pthread_cond_wait(&pool.myStartCond, &pool.myLock);
+    bool quit = pool.myQuitFlag;
+    generation = pool.myGeneration;
+    pthread_mutex_unlock(&pool.myLock);
+
+    if(quit)
+      break;
+
+    pool.work(worker->thread);
+
+    pthread_mutex_lock(&pool.myLock);
+    if(--pool.myBusyWorkers == 0)
+      pthread_cond_signal(&pool.myDoneCond);
+    pthread_mutex_unlock(&pool.myLock);
+  }
+
+  return NULL;
+}
+#endif
@@ -0,0 +1,170 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll       
+//  SS  SS   tt           ll   ll        
+//  SS     tttttt  eeee   ll   ll   aaaa 
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2009 by Bradford W. Mott and the Stella team
+//
+// See the file "license" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//
+// $Id$
+//============================================================================
+
+#ifndef THREAD_POOL_HXX
+#define THREAD_POOL_HXX
+
+#include "bspf.hxx"
+
+#if (defined(BSPF_UNIX) || defined(BSPF_MAC_OSX)) && !defined(WII)
+  #define THREAD_POOL_PTHREADS
+  #include <pthread.h>
+#endif
+
+/**
+  A small work-stealing thread pool, used to run many independent jobs
+  (typically one per console) in parallel.
+
+  Each call to run() splits the jobs into one contiguous range per
+  thread.  A thread takes jobs from the front of its own range, and when
+  that's empty it steals the back half of the range of another thread.
+  This keeps all threads busy even when some jobs (ROMs) are much more
+  expensive than others.  The calling thread takes part in the work, so
+  a pool with one thread doesn't create any extra threads at all.
+
+  On platforms without pthreads, the jobs are simply run in order by
+  the calling thread.
+
+  @author  Stella team
+  @version $Id$
+*/
+class ThreadPool
+{
+  public:
+    /**
+      The work done by the pool.  execute() is called exactly once for
+      each job index, possibly from different threads at the same time.
+    */
+    class Task
+    {
+      public:
+        virtual ~Task() { }
+        virtual void execute(uInt32 index) = 0;
+    };
+
+  public:
+    /**
+      Create a new thread pool.
+
+      @param threads  The number of threads (including the calling thread)
+                      to use, or 0 to use one for each processor
+    */
+    ThreadPool(uInt32 threads = 0);
+
+    /**
+      Destructor; waits for all threads to exit
+    */
+    virtual ~ThreadPool();
+
+  public:
+    /**
+      Run the given task for job indices 0 to count-1, and wait until
+      all of them are finished.
+
+      @param task   The task to execute
+      @param count  The number of jobs
+    */
+    void run(Task& task, uInt32 count);
+
+    /**
+      Answers the number of threads used by the pool.
+    */
+    uInt32 threads() const { return myNumThreads; }
+
+    /**
+      Answers the number of processors available on this machine.
+    */
+    static uInt32 processors();
+
+  private:
+    // Get the next job for the given thread, from its own range or by
+    // stealing from another one; answers false when no jobs are left
+    bool nextJob(uInt32 thread, uInt32& index);
+
+    // Execute jobs until there are none left
+    void work(uInt32 thread);
+
+#ifdef THREAD_POOL_PTHREADS
+    // Entry point of the worker threads
+    static void* workerMain(void* arg);
+#endif
+
+  private:
+    // The range of job indices still to be done by one thread
+    struct Range
+    {
+      uInt32 begin;
+      uInt32 end;
+#ifdef THREAD_POOL_PTHREADS
+      pthread_mutex_t lock;
+#endif
+    };
+
+    // Passed to each worker thread at creation
+    struct Worker
+    {
+      ThreadPool* pool;
+      uInt32 thread;
+    };
+
+    // Number of threads, including the calling one
+    uInt32 myNumThreads;
+
+    // One job range per thread
+    Range* myRanges;
+
+    // Number of entries in myRanges, which may exceed the number of
+    // threads if some of them couldn't be created
+    uInt32 myNumRanges;
+
+    // The task being run
+    Task* myTask;
+
+#ifdef THREAD_POOL_PTHREADS
+    // The worker threads (all threads except the calling one)
+    pthread_t* myThreads;
+    Worker* myWorkers;
+
+    // Protects the members below
+    pthread_mutex_t myLock;
+
+    // Signalled when a new batch of jobs starts, or the pool is destroyed
+    pthread_cond_t myStartCond;
+
+    // Signalled when the last worker finishes a batch
+    pthread_cond_t myDoneCond;
+
+    // Incremented for every batch, so workers can tell a new one started
+    uInt32 myGeneration;
+
+    // Number of worker threads still busy with the current batch
+    uInt32 myBusyWorkers;
+
+    // Set when the worker threads should exit
+    bool myQuitFlag;
+#endif
+
+  private:
+    // Copy constructor isn't supported by this class so make it private
+    ThreadPool(const ThreadPool&);
+
+    // Assignment operator isn't supported by this class so make it private
+    ThreadPool& operator = (const ThreadPool&);
+};
+
+#endif
@@ -0,0 +1,121 @@
+MODULE := src/libstella
+
+MODULE_OBJS := \
+	src/libstella/SoundBuffer.o \
+	src/libstella/StellaBatch.o \
+	src/libstella/StellaCore.o \
+	src/libstella/ThreadPool.o
+
+MODULE_DIRS += \
+	src/libstella
+
+# The headless core library contains the emulation core only; it doesn't
+# use OSystem, FrameBuffer or EventHandler, and builds without the SDL
+# headers.  The core only talks to the OSystem through the Frontend
+# interface, and a headless console has no frontend at all.
+# The debugger hooks in the 6502 code need the debugger module (and through
+# it SDL), so the library can only be built from a tree configured with
+# --disable-debugger; asking for it otherwise stops with an error.
+# On UNIX and OSX, StellaBatch runs consoles on several threads, so
+# programs linking the library also need -lpthread.
+LIBSTELLA := libstella.a
+
+LIBSTELLA_OBJS := \
+	$(MODULE_OBJS) \
+	src/emucore/AtariVox.o \
+	src/emucore/BlipBuffer.o \
+	src/emucore/Booster.o \
+	src/emucore/Cart.o \
+	src/emucore/Cart0840.o \
+	src/emucore/Cart2K.o \
+	src/emucore/Cart3E.o \
+	src/emucore/Cart3F.o \
+	src/emucore/Cart4A50.o \
+	src/emucore/Cart4K.o \
+	src/emucore/CartAR.o \
+	src/emucore/CartCV.o \
+	src/emucore/CartDPC.o \
+	src/emucore/CartE0.o \
+	src/emucore/CartE7.o \
+	src/emucore/CartEF.o \
+	src/emucore/CartEFSC.o \
+	src/emucore/CartF4.o \
+	src/emucore/CartF4SC.o \
+	src/emucore/CartF6.o \
+	src/emucore/CartF6SC.o \
+	src/emucore/CartF8.o \
+	src/emucore/CartF8SC.o \
+	src/emucore/CartFASC.o \
+	src/emucore/CartFE.o \
+	src/emucore/CartMB.o \
+	src/emucore/CartMC.o \
+	src/emucore/CartSB.o \
+	src/emucore/CartUA.o \
+	src/emucore/CartX07.o \
+	src/emucore/Console.o \
+	src/emucore/Control.o \
+	src/emucore/Deserializer.o \
+	src/emucore/DetectionCache.o \
+	src/emucore/Driving.o \
+	src/emucore/Event.o \
+	src/emucore/HashLog.o \
+	src/emucore/Joystick.o \
+	src/emucore/Keyboard.o \
+	src/emucore/KidVid.o \
+	src/emucore/M6532.o \
+	src/emucore/MD5.o \
+	src/emucore/Movie.o \
+	src/emucore/MT24LC256.o \
+	src/emucore/Paddles.o \
+	src/emucore/PerfCounters.o \
+	src/emucore/Props.o \
+	src/emucore/Random.o \
+	src/emucore/RewindBuffer.o \
+	src/emucore/RunAhead.o \
+	src/emucore/SaveKey.o \
+	src/emucore/Serializer.o \
+	src/emucore/Settings.o \
+	src/emucore/Switches.o \
+	src/emucore/TIA.o \
+	src/emucore/TIASnd.o \
+	src/emucore/TIATables.o \
+	src/emucore/TrackBall.o \
+	src/emucore/m6502/src/Device.o \
+	src/emucore/m6502/src/M6502.o \
+	src/emucore/m6502/src/M6502Hi.o \
+	src/emucore/m6502/src/M6502Low.o \
+	src/emucore/m6502/src/NullDev.o \
+	src/emucore/m6502/src/System.o
+
+ifneq ($(findstring -DDEBUGGER_SUPPORT,$(DEFINES)),)
+$(LIBSTELLA):
+	@echo "libstella can't include the debugger; run configure with --disable-debugger"
+	@false
+else
+$(LIBSTELLA): $(LIBSTELLA_OBJS)
+	-$(RM) $@
+	$(AR) $@ $+
+	$(RANLIB) $@
+endif
+
+# Pseudo target for comfort, allows for "make libstella"
+libstella: $(LIBSTELLA)
+
+# The ROM corpus benchmark, run as "stellabench [options] <romdir>"
+# (see StellaBench.cxx); it isn't part of the emulator itself.  It also
+# needs the platform's filesystem node, which is already in OBJS.
+STELLABENCH := stellabench
+STELLABENCH_OBJS := src/libstella/StellaBench.o src/emucore/FSNode.o \
+	$(filter %/FSNodePOSIX.o %/FSNodeWin32.o %/FSNodeGP2X.o, $(OBJS))
+
+$(STELLABENCH): $(STELLABENCH_OBJS) $(LIBSTELLA)
+	$(LD) $(LDFLAGS) $+ -lpthread -o $@
+
+# Pseudo target for comfort, allows for "make bench"
+bench: $(STELLABENCH)
+
+clean: clean-libstella
+clean-libstella:
+	-$(RM) $(MODULE_OBJS) $(LIBSTELLA) $(STELLABENCH_OBJS) $(STELLABENCH)
+
+.PHONY: libstella bench clean-libstella
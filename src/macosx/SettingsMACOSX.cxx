@@ -27,6 +27,7 @@
 #include "bspf.hxx"
 #include "Console.hxx"
 #include "EventHandler.hxx"
+#include "OSystem.hxx"
 #include "Version.hxx"
 
 #include "Settings.hxx"
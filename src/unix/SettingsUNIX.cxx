@@ -17,6 +17,7 @@
 //============================================================================
 
 #include "bspf.hxx"
+#include "OSystem.hxx"
 #include "Settings.hxx"
 #include "SettingsUNIX.hxx"
 
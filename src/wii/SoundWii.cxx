@@ -54,7 +54,8 @@ myDisplayFrameRate(60.0),
 myNumChannels(1),
 myFragmentSizeLogBase2(0),
 myIsMuted(true),
-myVolume(100)
+myVolume(100),
+myProcessingTime(0)
 {
 }
 
@@ -548,6 +549,8 @@ void SoundWii::update(void)
 
     if (myIsMuted) return;
 
+    uInt32 start = PerfCounters::ticks();
+
     static u8 buffer[4096];
     unsigned int nsamples = (SAMPLERATE / (int)myDisplayFrameRate);
     memset( buffer, 0x80, 4096 );
@@ -571,6 +574,8 @@ void SoundWii::update(void)
 #endif
 
     PlaySound( (u32*)buffer, ( audio_convert.len_cvt / 4 ) );        
+
+    myProcessingTime += PerfCounters::ticks() - start;
 }
 
 //#endif
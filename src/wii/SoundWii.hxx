@@ -136,6 +136,12 @@ class SoundWii : public Sound
     */
     void adjustVolume(Int8 direction);
 
+    /**
+      Answers the total host time spent generating samples, in
+      microseconds.
+    */
+    uInt32 processingTime() const { return myProcessingTime; }
+
   public:
     /**
       Loads the current state of this device from the given Deserializer.
@@ -265,6 +271,9 @@ class SoundWii : public Sound
     // Current volume as a percentage (0 - 100)
     uInt32 myVolume;
 
+    // Total host time spent generating samples, in microseconds
+    uInt32 myProcessingTime;
+
     // Audio specification structure
     //SDL_AudioSpec myHardwareSpec;
 
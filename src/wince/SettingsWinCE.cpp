@@ -21,6 +21,7 @@
 #include <fstream>
 
 #include "bspf.hxx"
+#include "OSystem.hxx"
 #include "Settings.hxx"
 #include "SettingsWinCE.hxx"
 
@@ -68,7 +68,8 @@ void setInput(const char *in) {
 	state = ST_DEFAULT;
 }
 
-int parse(const char *in) {
+int parse(const char *in, Debugger& dbg) {
+	debugger = &dbg;
 	lastExp = 0;
 	errMsg = "(no error)";
 	setInput(in);
@@ -102,7 +103,7 @@ inline bool is_operator(char x) {
 // responsibility, not the lexer's
 int const_to_int(char *c) {
 	// what base is the input in?
-	BaseFormat base = Debugger::debugger().parser().base();
+	BaseFormat base = debugger->parser().base();
 
 	switch(*c) {
 		case '\\':
@@ -273,7 +274,7 @@ int yylex() {
 					// happen if the user defines a label that matches one of
 					// the specials. Who would do that, though?
 
-					if(Debugger::debugger().equates().getAddress(idbuf) > -1) {
+					if(debugger->equates().getAddress(idbuf) > -1) {
 						yylval.equate = idbuf;
 						return EQUATE;
 					} else if( (cpuMeth = getCpuSpecial(idbuf)) ) {
@@ -282,7 +283,7 @@ int yylex() {
 					} else if( (tiaMeth = getTiaSpecial(idbuf)) ) {
 						yylval.tiaMethod = tiaMeth;
 						return TIA_METHOD;
-					} else if( Debugger::debugger().getFunction(idbuf) != 0) {
+					} else if( debugger->getFunction(idbuf) != 0) {
 						yylval.function = idbuf;
 						return FUNCTION;
 					} else {
@@ -24,12 +24,14 @@
 
 #include "Expression.hxx"
 
+class Debugger;
+
 //#ifdef __cplusplus
 //extern "C" {
 //#endif
 
 namespace YaccParser {
-	int parse(const char *);
+	int parse(const char *, Debugger&);
 	Expression *getResult();
 	const string& errorMessage();
 }
@@ -114,6 +114,9 @@
 
 Expression* lastExp = 0;
 
+/* debugger that the expressions being parsed refer to */
+Debugger* debugger = 0;
+
 #define YYERROR_VERBOSE 1
 
 /* dump Expression stack during parsing? */
@@ -157,7 +160,7 @@ void yyerror(const char *e) {
 
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 typedef union YYSTYPE
-#line 29 "stella.y"
+#line 32 "stella.y"
 {
 	int val;
 	char *equate;
@@ -1451,172 +1454,172 @@ yyreduce:
   switch (yyn)
     {
         case 2:
-#line 65 "stella.y"
+#line 68 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, "\ndone\n"); result.exp = (yyvsp[(1) - (1)].exp); }
     break;
 
   case 3:
-#line 68 "stella.y"
+#line 71 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " +"); (yyval.exp) = new PlusExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 4:
-#line 69 "stella.y"
+#line 72 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " -"); (yyval.exp) = new MinusExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 5:
-#line 70 "stella.y"
+#line 73 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " *"); (yyval.exp) = new MultExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 6:
-#line 71 "stella.y"
+#line 74 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " /"); (yyval.exp) = new DivExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 7:
-#line 72 "stella.y"
+#line 75 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " %%"); (yyval.exp) = new ModExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp));  lastExp = (yyval.exp); }
     break;
 
   case 8:
-#line 73 "stella.y"
+#line 76 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " &"); (yyval.exp) = new BinAndExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 9:
-#line 74 "stella.y"
+#line 77 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " |"); (yyval.exp) = new BinOrExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 10:
-#line 75 "stella.y"
+#line 78 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " ^"); (yyval.exp) = new BinXorExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 11:
-#line 76 "stella.y"
+#line 79 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " <"); (yyval.exp) = new LessExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 12:
-#line 77 "stella.y"
+#line 80 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " >"); (yyval.exp) = new GreaterExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 13:
-#line 78 "stella.y"
+#line 81 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " >="); (yyval.exp) = new GreaterEqualsExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 14:
-#line 79 "stella.y"
+#line 82 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " <="); (yyval.exp) = new LessEqualsExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 15:
-#line 80 "stella.y"
+#line 83 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " !="); (yyval.exp) = new NotEqualsExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 16:
-#line 81 "stella.y"
+#line 84 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " =="); (yyval.exp) = new EqualsExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 17:
-#line 82 "stella.y"
+#line 85 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " >>"); (yyval.exp) = new ShiftRightExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 18:
-#line 83 "stella.y"
+#line 86 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " <<"); (yyval.exp) = new ShiftLeftExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 19:
-#line 84 "stella.y"
+#line 87 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " ||"); (yyval.exp) = new LogOrExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 20:
-#line 85 "stella.y"
+#line 88 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " &&"); (yyval.exp) = new LogAndExpression((yyvsp[(1) - (3)].exp), (yyvsp[(3) - (3)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 21:
-#line 86 "stella.y"
+#line 89 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " U-"); (yyval.exp) = new UnaryMinusExpression((yyvsp[(2) - (2)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 22:
-#line 87 "stella.y"
+#line 90 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " ~"); (yyval.exp) = new BinNotExpression((yyvsp[(2) - (2)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 23:
-#line 88 "stella.y"
+#line 91 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " !"); (yyval.exp) = new LogNotExpression((yyvsp[(2) - (2)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 24:
-#line 89 "stella.y"
-    { if(DEBUG_EXP) fprintf(stderr, " U*"); (yyval.exp) = new ByteDerefExpression((yyvsp[(2) - (2)].exp)); lastExp = (yyval.exp); }
+#line 92 "stella.y"
+    { if(DEBUG_EXP) fprintf(stderr, " U*"); (yyval.exp) = new ByteDerefExpression(*debugger, (yyvsp[(2) - (2)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 25:
-#line 90 "stella.y"
-    { if(DEBUG_EXP) fprintf(stderr, " U@"); (yyval.exp) = new WordDerefExpression((yyvsp[(2) - (2)].exp)); lastExp = (yyval.exp); }
+#line 93 "stella.y"
+    { if(DEBUG_EXP) fprintf(stderr, " U@"); (yyval.exp) = new WordDerefExpression(*debugger, (yyvsp[(2) - (2)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 26:
-#line 91 "stella.y"
+#line 94 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " U<");  (yyval.exp) = new LoByteExpression((yyvsp[(2) - (2)].exp));  lastExp = (yyval.exp); }
     break;
 
   case 27:
-#line 92 "stella.y"
+#line 95 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " U>");  (yyval.exp) = new HiByteExpression((yyvsp[(2) - (2)].exp));  lastExp = (yyval.exp); }
     break;
 
   case 28:
-#line 93 "stella.y"
+#line 96 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " ()"); (yyval.exp) = (yyvsp[(2) - (3)].exp); lastExp = (yyval.exp); }
     break;
 
   case 29:
-#line 94 "stella.y"
-    { if(DEBUG_EXP) fprintf(stderr, " []"); (yyval.exp) = new ByteDerefOffsetExpression((yyvsp[(1) - (4)].exp), (yyvsp[(3) - (4)].exp)); lastExp = (yyval.exp); }
+#line 97 "stella.y"
+    { if(DEBUG_EXP) fprintf(stderr, " []"); (yyval.exp) = new ByteDerefOffsetExpression(*debugger, (yyvsp[(1) - (4)].exp), (yyvsp[(3) - (4)].exp)); lastExp = (yyval.exp); }
     break;
 
   case 30:
-#line 95 "stella.y"
+#line 98 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " %d", (yyvsp[(1) - (1)].val)); (yyval.exp) = new ConstExpression((yyvsp[(1) - (1)].val)); lastExp = (yyval.exp); }
     break;
 
   case 31:
-#line 96 "stella.y"
-    { if(DEBUG_EXP) fprintf(stderr, " %s", (yyvsp[(1) - (1)].equate)); (yyval.exp) = new EquateExpression((yyvsp[(1) - (1)].equate)); lastExp = (yyval.exp); }
+#line 99 "stella.y"
+    { if(DEBUG_EXP) fprintf(stderr, " %s", (yyvsp[(1) - (1)].equate)); (yyval.exp) = new EquateExpression(*debugger, (yyvsp[(1) - (1)].equate)); lastExp = (yyval.exp); }
     break;
 
   case 32:
-#line 97 "stella.y"
-    { if(DEBUG_EXP) fprintf(stderr, " (CpuMethod)"); (yyval.exp) = new CpuMethodExpression((yyvsp[(1) - (1)].cpuMethod)); lastExp = (yyval.exp); }
+#line 100 "stella.y"
+    { if(DEBUG_EXP) fprintf(stderr, " (CpuMethod)"); (yyval.exp) = new CpuMethodExpression(*debugger, (yyvsp[(1) - (1)].cpuMethod)); lastExp = (yyval.exp); }
     break;
 
   case 33:
-#line 98 "stella.y"
-    { if(DEBUG_EXP) fprintf(stderr, " (TiaMethod)"); (yyval.exp) = new TiaMethodExpression((yyvsp[(1) - (1)].tiaMethod)); lastExp = (yyval.exp); }
+#line 101 "stella.y"
+    { if(DEBUG_EXP) fprintf(stderr, " (TiaMethod)"); (yyval.exp) = new TiaMethodExpression(*debugger, (yyvsp[(1) - (1)].tiaMethod)); lastExp = (yyval.exp); }
     break;
 
   case 34:
-#line 99 "stella.y"
-    { if(DEBUG_EXP) fprintf(stderr, " (function)"); (yyval.exp) = new FunctionExpression((yyvsp[(1) - (1)].function)); lastExp = (yyval.exp); }
+#line 102 "stella.y"
+    { if(DEBUG_EXP) fprintf(stderr, " (function)"); (yyval.exp) = new FunctionExpression(*debugger, (yyvsp[(1) - (1)].function)); lastExp = (yyval.exp); }
     break;
 
   case 35:
-#line 100 "stella.y"
+#line 103 "stella.y"
     { if(DEBUG_EXP) fprintf(stderr, " ERR"); yyerror((char*)"Invalid label or constant"); return 1; }
     break;
 
@@ -1836,6 +1839,6 @@ yyreturn:
 }
 
 
-#line 102 "stella.y"
+#line 105 "stella.y"
 
 